@@ -11,21 +11,45 @@
 
 #include "fixed.h"
 
+//Mus stream ring depth in chunks, each chunk takes 26KB of SPU RAM per channel
+#define AUDIO_STREAM_CHUNKS_MIN     2
+#define AUDIO_STREAM_CHUNKS_MAX     4
+#define AUDIO_STREAM_CHUNKS_DEFAULT 2
+
+//Mus stream stats, reset whenever a mus is loaded
+typedef struct
+{
+	u32 underruns;       //Chunks that started playing before they were filled
+	u32 late_refills;    //Chunks that finished playing while the drive was still busy
+	fixed_t max_latency; //Longest time a chunk took to refill
+} Audio_StreamStats;
+
+//Sound priorities, a sound can only take the voice of one with the same or lower priority
+#define AUDIO_PRIORITY_LOW    0
+#define AUDIO_PRIORITY_NORMAL 1
+#define AUDIO_PRIORITY_HIGH   2
+
 //Audio interface
 void Audio_Init(void);
 void Audio_Quit(void);
+void Audio_SetStreamChunks(u8 chunks); //Frees all sounds, so call this before loading them
+fixed_t Audio_GetStreamHeadroom(void);
+void Audio_GetStreamStats(Audio_StreamStats *stats);
 void Audio_LoadMusFile(CdlFILE *file);
 void Audio_LoadMus(const char *path);
+void Audio_PrefetchMus(const char *path);
 void Audio_PlayMus(boolean loops);
 void Audio_StopMus(void);
 void Audio_SetVolume(u8 i, u16 vol_left, u16 vol_right);
 fixed_t Audio_GetTime(void);
+fixed_t Audio_GetTimeJitter(void);
 boolean Audio_IsPlaying(void);
 void findFreeChannel(void);
 u32 Audio_LoadVAGData(u32 *sound, u32 sound_size);
 void AudioPlayVAG(int channel, u32 addr);
 void Audio_PlaySoundOnChannel(u32 addr, u32 channel);
 void Audio_PlaySound(u32 addr);
+void Audio_PlaySoundEx(u32 addr, u8 priority, u16 volume, u16 pitch);
 void Audio_ClearAlloc(void);
 
 #endif
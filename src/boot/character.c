@@ -9,6 +9,23 @@
 #include "mem.h"
 #include "stage.h"
 
+//Character animation attributes
+const CharAnimAttr char_anim_attr[CHAR_ANIM_ATTR_MAX] = {
+	0,                                  //CharAnim_Idle
+	CHAR_ANIM_SING | 0,                 //CharAnim_Left
+	CHAR_ANIM_SING | CHAR_ANIM_ALT | 0, //CharAnim_LeftAlt
+	CHAR_ANIM_SING | 1,                 //CharAnim_Down
+	CHAR_ANIM_SING | CHAR_ANIM_ALT | 1, //CharAnim_DownAlt
+	CHAR_ANIM_SING | 2,                 //CharAnim_Up
+	CHAR_ANIM_SING | CHAR_ANIM_ALT | 2, //CharAnim_UpAlt
+	CHAR_ANIM_SING | 3,                 //CharAnim_Right
+	CHAR_ANIM_SING | CHAR_ANIM_ALT | 3, //CharAnim_RightAlt
+	CHAR_ANIM_MISS | 0,                 //PlayerAnim_LeftMiss
+	CHAR_ANIM_MISS | 1,                 //PlayerAnim_DownMiss
+	CHAR_ANIM_MISS | 2,                 //PlayerAnim_UpMiss
+	CHAR_ANIM_MISS | 3,                 //PlayerAnim_RightMiss
+};
+
 //Character functions
 void Character_Free(Character *this)
 {
@@ -21,9 +38,10 @@ void Character_Free(Character *this)
 	Mem_Free(this);
 }
 
-void Character_Init(Character *this, fixed_t x, fixed_t y)
+void Character_Init(Character *this, u32 size, fixed_t x, fixed_t y)
 {
 	//Perform common character initialization
+	this->size = size;
 	this->x = x;
 	this->y = y;
 	
@@ -33,6 +51,32 @@ void Character_Init(Character *this, fixed_t x, fixed_t y)
 	this->sing_end = 0;
 }
 
+Character *Character_Snapshot(const Character *this)
+{
+	//Check if NULL
+	if (this == NULL)
+		return NULL;
+	
+	//Copy the whole character object
+	Character *snapshot = Mem_Alloc(this->size);
+	if (snapshot != NULL)
+		memcpy(snapshot, this, this->size);
+	return snapshot;
+}
+
+void Character_Restore(Character *this, const Character *snapshot)
+{
+	//Put the character back the way it was when the snapshot was taken
+	if (this != NULL && snapshot != NULL && snapshot->size == this->size)
+	{
+		memcpy(this, snapshot, this->size);
+		
+		//The snapshot's sheet may no longer be the one in VRAM, restart the animation so the next tick loads it again
+		this->frame = this->tex_id = 0xFF;
+		Animatable_SetAnim(&this->animatable, this->animatable.anim);
+	}
+}
+
 void Character_DrawParallax(Character *this, Gfx_Tex *tex, const CharFrame *cframe, fixed_t parallax)
 {
 	s16 offx;
@@ -66,37 +110,13 @@ void Character_Draw(Character *this, Gfx_Tex *tex, const CharFrame *cframe)
 void Character_CheckStartSing(Character *this)
 {
 	//Update sing end if singing animation
-	if (this->animatable.anim == CharAnim_Left ||
-	    this->animatable.anim == CharAnim_LeftAlt ||
-	    this->animatable.anim == CharAnim_Down ||
-	    this->animatable.anim == CharAnim_DownAlt ||
-	    this->animatable.anim == CharAnim_Up ||
-	    this->animatable.anim == CharAnim_UpAlt ||
-	    this->animatable.anim == CharAnim_Right ||
-	    this->animatable.anim == CharAnim_RightAlt ||
-	    ((this->spec & CHAR_SPEC_MISSANIM) &&
-	    (this->animatable.anim == PlayerAnim_LeftMiss ||
-	     this->animatable.anim == PlayerAnim_DownMiss ||
-	     this->animatable.anim == PlayerAnim_UpMiss ||
-	     this->animatable.anim == PlayerAnim_RightMiss)))
+	if (Character_AnimAttr(this) & (CHAR_ANIM_SING | CHAR_ANIM_MISS))
 		this->sing_end = stage.note_scroll + (FIXED_DEC(12,1) << 2); //1 beat
 }
 
 void Character_CheckEndSing(Character *this)
 {
-	if ((this->animatable.anim == CharAnim_Left ||
-	     this->animatable.anim == CharAnim_LeftAlt ||
-	     this->animatable.anim == CharAnim_Down ||
-	     this->animatable.anim == CharAnim_DownAlt ||
-	     this->animatable.anim == CharAnim_Up ||
-	     this->animatable.anim == CharAnim_UpAlt ||
-	     this->animatable.anim == CharAnim_Right ||
-	     this->animatable.anim == CharAnim_RightAlt ||
-	    ((this->spec & CHAR_SPEC_MISSANIM) &&
-	    (this->animatable.anim == PlayerAnim_LeftMiss ||
-	     this->animatable.anim == PlayerAnim_DownMiss ||
-	     this->animatable.anim == PlayerAnim_UpMiss ||
-	     this->animatable.anim == PlayerAnim_RightMiss))) &&
+	if ((Character_AnimAttr(this) & (CHAR_ANIM_SING | CHAR_ANIM_MISS)) &&
 	    stage.note_scroll >= this->sing_end)
 		this->set_anim(this, CharAnim_Idle);
 }
@@ -107,14 +127,7 @@ void Character_PerformIdle(Character *this)
 	if (stage.flag & STAGE_FLAG_JUST_STEP)
 	{
 		if (Animatable_Ended(&this->animatable) &&
-		    (this->animatable.anim != CharAnim_Left &&
-		     this->animatable.anim != CharAnim_LeftAlt &&
-		     this->animatable.anim != CharAnim_Down &&
-		     this->animatable.anim != CharAnim_DownAlt &&
-		     this->animatable.anim != CharAnim_Up &&
-		     this->animatable.anim != CharAnim_UpAlt &&
-		     this->animatable.anim != CharAnim_Right &&
-		     this->animatable.anim != CharAnim_RightAlt) &&
+		    !(Character_AnimAttr(this) & CHAR_ANIM_SING) &&
 		    (stage.song_step & 0x7) == 0)
 			this->set_anim(this, CharAnim_Idle);
 	}
@@ -29,6 +29,16 @@ typedef enum
 	CharAnim_Max //Max standard/shared animation
 } CharAnim;
 
+//Animation attributes
+typedef u8 CharAnimAttr;
+#define CHAR_ANIM_LANE  0x3      //Lane of a sing or miss animation (left, down, up, right)
+#define CHAR_ANIM_SING  (1 << 2) //Sing animation
+#define CHAR_ANIM_MISS  (1 << 3) //Miss animation, only for characters with CHAR_SPEC_MISSANIM
+#define CHAR_ANIM_ALT   (1 << 4) //Alt animation
+#define CHAR_ANIM_ATTR_MAX 32
+
+extern const CharAnimAttr char_anim_attr[CHAR_ANIM_ATTR_MAX];
+
 //Character structures
 typedef struct
 {
@@ -43,6 +53,7 @@ typedef struct Character
 	void (*tick)(struct Character*);
 	void (*set_anim)(struct Character*, u8);
 	void (*free)(struct Character*);
+	u32 size; //Size of the full object, for snapshots
 	
 	//Position
 	fixed_t x, y;
@@ -53,6 +64,9 @@ typedef struct Character
 	fixed_t focus_x, focus_y, focus_zoom;
 	boolean flip, ignoreanim;
 	
+	//Render state, the current frame and the sheet loaded for it (0xFF forces a load)
+	u8 frame, tex_id;
+	
 	//Animation state
 	Animatable animatable;
 	fixed_t sing_end;
@@ -60,8 +74,22 @@ typedef struct Character
 } Character;
 
 //Character functions
+static inline CharAnimAttr Character_AnimAttr(const Character *this)
+{
+	//Get attributes of the current animation, miss animations only count for characters that have them
+	u8 anim = this->animatable.anim;
+	if (anim >= CHAR_ANIM_ATTR_MAX)
+		return 0;
+	CharAnimAttr attr = char_anim_attr[anim];
+	if (!(this->spec & CHAR_SPEC_MISSANIM))
+		attr &= ~CHAR_ANIM_MISS;
+	return attr;
+}
+
 void Character_Free(Character *this);
-void Character_Init(Character *this, fixed_t x, fixed_t y);
+void Character_Init(Character *this, u32 size, fixed_t x, fixed_t y);
+Character *Character_Snapshot(const Character *this);
+void Character_Restore(Character *this, const Character *snapshot);
 void Character_DrawParallax(Character *this, Gfx_Tex *tex, const CharFrame *cframe, fixed_t parallax);
 void Character_Draw(Character *this, Gfx_Tex *tex, const CharFrame *cframe);
 
@@ -4,17 +4,13 @@
   file, You can obtain one at http://mozilla.org/MPL/2.0/.
 */
 
-#include "boot/character.h"
-#include "boot/mem.h"
-#include "boot/archive.h"
-#include "boot/stage.h"
-#include "boot/random.h"
-#include "boot/main.h"
+#include "bf.h"
 
-//Boyfriend player assets
-static u8 char_bf_arc_main[] = {
-	#include "iso/bf/main.arc.h"
-};
+#include "../mem.h"
+#include "../archive.h"
+#include "../stage.h"
+#include "../random.h"
+#include "../main.h"
 
 //Boyfriend skull fragments
 static SkullFragment char_bf_skull[15] = {
@@ -65,7 +61,6 @@ typedef struct
 	IO_Data arc_ptr[BF_ArcMain_Max];
 	
 	Gfx_Tex tex, tex_retry;
-	u8 frame, tex_id;
 	u8 retry_bump;
 	
 	SkullFragment skull[COUNT_OF(char_bf_skull)];
@@ -165,12 +160,12 @@ static void Char_BF_SetFrame(void *user, u8 frame)
 	Char_BF *this = (Char_BF*)user;
 	
 	//Check if this is a new frame
-	if (frame != this->frame)
+	if (frame != this->character.frame)
 	{
 		//Check if new art shall be loaded
-		const CharFrame *cframe = &char_bf_frame[this->frame = frame];
-		if (cframe->tex != this->tex_id)
-			Gfx_LoadTex(&this->tex, this->arc_ptr[this->tex_id = cframe->tex], 0);
+		const CharFrame *cframe = &char_bf_frame[this->character.frame = frame];
+		if (cframe->tex != this->character.tex_id)
+			Gfx_LoadTex(&this->tex, this->arc_ptr[this->character.tex_id = cframe->tex], 0);
 	}
 }
 
@@ -180,32 +175,14 @@ static void Char_BF_Tick(Character *character)
 	
 	//Handle animation updates
 	if ((character->pad_held & (INPUT_LEFT | INPUT_DOWN | INPUT_UP | INPUT_RIGHT)) == 0 ||
-	    (character->animatable.anim != CharAnim_Left &&
-	     character->animatable.anim != CharAnim_LeftAlt &&
-	     character->animatable.anim != CharAnim_Down &&
-	     character->animatable.anim != CharAnim_DownAlt &&
-	     character->animatable.anim != CharAnim_Up &&
-	     character->animatable.anim != CharAnim_UpAlt &&
-	     character->animatable.anim != CharAnim_Right &&
-	     character->animatable.anim != CharAnim_RightAlt))
+	    !(Character_AnimAttr(character) & CHAR_ANIM_SING))
 		Character_CheckEndSing(character);
 	
 	//Perform idle dance
 	if (stage.flag & STAGE_FLAG_JUST_STEP)
 	{
 		if (Animatable_Ended(&character->animatable) &&
-			(character->animatable.anim != CharAnim_Left &&
-		     character->animatable.anim != CharAnim_LeftAlt &&
-		     character->animatable.anim != PlayerAnim_LeftMiss &&
-		     character->animatable.anim != CharAnim_Down &&
-		     character->animatable.anim != CharAnim_DownAlt &&
-		     character->animatable.anim != PlayerAnim_DownMiss &&
-		     character->animatable.anim != CharAnim_Up &&
-		     character->animatable.anim != CharAnim_UpAlt &&
-		     character->animatable.anim != PlayerAnim_UpMiss &&
-		     character->animatable.anim != CharAnim_Right &&
-		     character->animatable.anim != CharAnim_RightAlt &&
-		     character->animatable.anim != PlayerAnim_RightMiss) &&
+		    !(Character_AnimAttr(character) & (CHAR_ANIM_SING | CHAR_ANIM_MISS)) &&
 			(stage.song_step & 0x7) == 0)
 			character->set_anim(character, CharAnim_Idle);
 	}
@@ -312,7 +289,7 @@ static void Char_BF_Tick(Character *character)
 	
 	//Animate and draw character
 	Animatable_Animate(&character->animatable, (void*)this, Char_BF_SetFrame);
-	Character_Draw(character, &this->tex, &char_bf_frame[this->frame]);
+	Character_Draw(character, &this->tex, &char_bf_frame[this->character.frame]);
 }
 
 static void Char_BF_SetAnim(Character *character, u8 anim)
@@ -344,7 +321,7 @@ static void Char_BF_Free(Character *character)
 	(void)character;
 }
 
-static Character *Char_BF_New(fixed_t x, fixed_t y)
+Character *Char_BF_New(fixed_t x, fixed_t y)
 {
 	//Allocate boyfriend object
 	Char_BF *this = Mem_Alloc(sizeof(Char_BF));
@@ -361,7 +338,7 @@ static Character *Char_BF_New(fixed_t x, fixed_t y)
 	this->character.free = Char_BF_Free;
 	
 	Animatable_Init(&this->character.animatable, char_bf_anim);
-	Character_Init((Character*)this, x, y);
+	Character_Init((Character*)this, sizeof(*this), x, y);
 	
 	//Set character information
 	this->character.spec = CHAR_SPEC_MISSANIM;
@@ -388,12 +365,13 @@ static Character *Char_BF_New(fixed_t x, fixed_t y)
 		"retry.tim", //BF_ArcMain_Retry
 		NULL
 	};
+	IO_Data arc_main = Resident_Get(Resident_BF);
 	IO_Data *arc_ptr = this->arc_ptr;
 	for (; *pathp != NULL; pathp++)
-		*arc_ptr++ = Archive_Find((IO_Data)char_bf_arc_main, *pathp);
+		*arc_ptr++ = Archive_Find(arc_main, *pathp);
 	
 	//Initialize render state
-	this->tex_id = this->frame = 0xFF;
+	this->character.tex_id = this->character.frame = 0xFF;
 
 	//Initialize player state
 	this->retry_bump = 0;
@@ -0,0 +1,15 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#ifndef PSXF_GUARD_BF_H
+#define PSXF_GUARD_BF_H
+
+#include "../character.h"
+
+//Boyfriend player functions, art is resident
+Character *Char_BF_New(fixed_t x, fixed_t y);
+
+#endif
@@ -0,0 +1,116 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "generic.h"
+
+#include "../mem.h"
+#include "../archive.h"
+#include "../stage.h"
+#include "../main.h"
+
+//Generic character functions
+static void Char_Generic_SetFrame(void *user, u8 frame)
+{
+	Char_Generic *this = (Char_Generic*)user;
+	
+	//Check if this is a new frame
+	if (frame != this->character.frame)
+	{
+		//Check if new art shall be loaded
+		const CharFrame *cframe = &this->frames[this->character.frame = frame];
+		if (cframe->tex != this->character.tex_id)
+			Gfx_LoadTex(&this->tex, this->arc_ptr[this->character.tex_id = cframe->tex], 0);
+	}
+}
+
+static void Char_Generic_Tick(Character *character)
+{
+	Char_Generic *this = (Char_Generic*)character;
+	
+	//Perform idle dance
+	if ((character->pad_held & (INPUT_LEFT | INPUT_DOWN | INPUT_UP | INPUT_RIGHT)) == 0)
+		Character_PerformIdle(character);
+	
+	//Animate and draw
+	Animatable_Animate(&character->animatable, (void*)this, Char_Generic_SetFrame);
+	Character_Draw(character, &this->tex, &this->frames[this->character.frame]);
+}
+
+static void Char_Generic_SetAnim(Character *character, u8 anim)
+{
+	//Set animation
+	Animatable_SetAnim(&character->animatable, anim);
+	Character_CheckStartSing(character);
+}
+
+static void Char_Generic_Free(Character *character)
+{
+	(void)character;
+}
+
+Character *Char_Generic_New(IO_Data arc, fixed_t x, fixed_t y)
+{
+	//Find definition in the character archive
+	const CharDef *def = (const CharDef*)Archive_Find(arc, "main.chr");
+	if (def == NULL)
+		return NULL;
+	
+	const char *textures = (const char*)(def + 1);
+	const CharFrame *frames = (const CharFrame*)(textures + def->textures * 12);
+	const CharDef_Anim *anims = (const CharDef_Anim*)(frames + def->frames);
+	const u8 *scripts = (const u8*)(anims + def->anims);
+	
+	//Allocate generic object, with the animation and texture tables after it
+	Char_Generic *this = Mem_Alloc(sizeof(Char_Generic) + sizeof(Animation) * def->anims + sizeof(IO_Data) * def->textures);
+	if (this == NULL)
+	{
+		sprintf(error_msg, "[Char_Generic_New] Failed to allocate generic object");
+		ErrorLock();
+		return NULL;
+	}
+	this->frames = frames;
+	this->anims = (Animation*)(this + 1);
+	this->arc_ptr = (IO_Data*)(this->anims + def->anims);
+	
+	//Point animations at their scripts
+	for (u8 i = 0; i < def->anims; i++)
+	{
+		this->anims[i].spd = anims[i].spd;
+		this->anims[i].script = scripts + anims[i].script;
+	}
+	
+	//Initialize character
+	this->character.tick = Char_Generic_Tick;
+	this->character.set_anim = Char_Generic_SetAnim;
+	this->character.free = Char_Generic_Free;
+	
+	Animatable_Init(&this->character.animatable, this->anims);
+	Character_Init((Character*)this, sizeof(*this), x, y);
+	
+	//Set character information
+	this->character.spec = def->spec;
+	
+	this->character.health_i = def->health_i;
+	this->character.health_b = def->health_b;
+	
+	this->character.focus_x = def->focus_x;
+	this->character.focus_y = def->focus_y;
+	this->character.focus_zoom = def->focus_zoom;
+	
+	//Load art
+	for (u8 i = 0; i < def->textures; i++)
+	{
+		char path[13];
+		memcpy(path, textures + i * 12, 12);
+		path[12] = '\0';
+		this->arc_ptr[i] = Archive_Find(arc, path);
+	}
+	
+	//Initialize render state
+	this->character.tex_id = this->character.frame = 0xFF;
+	
+	return (Character*)this;
+}
@@ -0,0 +1,47 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#ifndef PSXF_GUARD_GENERIC_H
+#define PSXF_GUARD_GENERIC_H
+
+#include "../character.h"
+
+//Character definition header, as written by funkinchrpak
+//Followed by the texture names, frames, animations and animation scripts
+typedef struct
+{
+	u8 spec, health_i, anims, textures;
+	u32 health_b;
+	fixed_t focus_x, focus_y, focus_zoom;
+	u16 frames, script_size;
+} CharDef;
+
+typedef struct
+{
+	u8 spd, pad;
+	u16 script;
+} CharDef_Anim;
+
+//Generic character structure
+typedef struct
+{
+	//Character base structure
+	Character character;
+	
+	//Definition data
+	const CharFrame *frames;
+	Animation *anims;
+	
+	//Render data and state
+	IO_Data *arc_ptr;
+	
+	Gfx_Tex tex;
+} Char_Generic;
+
+//Generic character functions
+Character *Char_Generic_New(IO_Data arc, fixed_t x, fixed_t y);
+
+#endif
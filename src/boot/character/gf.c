@@ -4,23 +4,14 @@
   file, You can obtain one at http://mozilla.org/MPL/2.0/.
 */
 
-#include "boot/character.h"
-#include "boot/mem.h"
-#include "boot/archive.h"
-#include "boot/stage.h"
-#include "boot/main.h"
+#include "gf.h"
 
-#include "speaker.c"
+#include "../mem.h"
+#include "../archive.h"
+#include "../stage.h"
+#include "../main.h"
 
-//GF assets
-static u8 char_gf_arc_main[] = {
-	#include "iso/gf/main.arc.h"
-};
-#ifdef CHAR_GF_TUTORIAL
-static u8 char_gf_arc_tut[] = {
-	#include "iso/gf/tut.arc.h"
-};
-#endif
+#include "speaker.h"
 
 //GF character structure
 enum
@@ -44,7 +35,9 @@ typedef struct
 	IO_Data arc_ptr[GF_Arc_Max];
 	
 	Gfx_Tex tex;
-	u8 frame, tex_id;
+	
+	fixed_t parallax;
+	boolean tutorial; //Sings in the tutorial
 	
 	//Speaker
 	Speaker speaker;
@@ -109,28 +102,26 @@ static void Char_GF_SetFrame(void *user, u8 frame)
 	Char_GF *this = (Char_GF*)user;
 	
 	//Check if this is a new frame
-	if (frame != this->frame)
+	if (frame != this->character.frame)
 	{
 		//Check if new art shall be loaded
-		const CharFrame *cframe = &char_gf_frame[this->frame = frame];
-		if (cframe->tex != this->tex_id)
-			Gfx_LoadTex(&this->tex, this->arc_ptr[this->tex_id = cframe->tex], 0);
+		const CharFrame *cframe = &char_gf_frame[this->character.frame = frame];
+		if (cframe->tex != this->character.tex_id)
+			Gfx_LoadTex(&this->tex, this->arc_ptr[this->character.tex_id = cframe->tex], 0);
 	}
 }
 
-static fixed_t Char_GF_GetParallax(Char_GF *this);
-
 static void Char_GF_Tick(Character *character)
 {
 	Char_GF *this = (Char_GF*)character;
 	
-	#ifdef CHAR_GF_TUTORIAL
 	//Stop singing after a beat
-	if (character->animatable.anim == CharAnim_Left ||
+	if (this->tutorial &&
+	   (character->animatable.anim == CharAnim_Left ||
 		character->animatable.anim == CharAnim_Down ||
 		character->animatable.anim == CharAnim_Up ||
 		character->animatable.anim == CharAnim_Right ||
-		character->animatable.anim == CharAnim_UpAlt)
+		character->animatable.anim == CharAnim_UpAlt))
 	{
 		if (character->pad_held == 0 && stage.note_scroll >= character->sing_end)
 		{
@@ -146,7 +137,6 @@ static void Char_GF_Tick(Character *character)
 	}
 	else
 	{
-	#endif
 		//Dance to the beat
 		if (stage.note_scroll >= character->sing_end)
 		{
@@ -162,28 +152,26 @@ static void Char_GF_Tick(Character *character)
 				Speaker_Bump(&this->speaker);
 			}
 		}
-	#ifdef CHAR_GF_TUTORIAL
 	}
-	#endif
 	
 	//Animate and draw
-	fixed_t parallax = Char_GF_GetParallax(this);
 	Animatable_Animate(&character->animatable, (void*)this, Char_GF_SetFrame);
-	Character_DrawParallax(character, &this->tex, &char_gf_frame[this->frame], parallax);
-	Speaker_Tick(&this->speaker, character->x, character->y, parallax);
+	Character_DrawParallax(character, &this->tex, &char_gf_frame[this->character.frame], this->parallax);
+	Speaker_Tick(&this->speaker, character->x, character->y, this->parallax);
 }
 
 static void Char_GF_SetAnim(Character *character, u8 anim)
 {
+	Char_GF *this = (Char_GF*)character;
+	
 	//Set animation
-	#ifdef CHAR_GF_TUTORIAL
-		if (anim == CharAnim_Left ||
-		    anim == CharAnim_Down ||
-		    anim == CharAnim_Up ||
-		    anim == CharAnim_Right ||
-		    anim == CharAnim_UpAlt)
-			character->sing_end = stage.note_scroll + (FIXED_DEC(12,1) << 2); //1 beat
-	#endif
+	if (this->tutorial &&
+	   (anim == CharAnim_Left ||
+	    anim == CharAnim_Down ||
+	    anim == CharAnim_Up ||
+	    anim == CharAnim_Right ||
+	    anim == CharAnim_UpAlt))
+		character->sing_end = stage.note_scroll + (FIXED_DEC(12,1) << 2); //1 beat
 	Animatable_SetAnim(&character->animatable, anim);
 }
 
@@ -192,7 +180,7 @@ static void Char_GF_Free(Character *character)
 	(void)character;
 }
 
-static Character *Char_GF_New(fixed_t x, fixed_t y)
+Character *Char_GF_New(fixed_t x, fixed_t y, fixed_t parallax, IO_Data arc_tut)
 {
 	//Allocate gf object
 	Char_GF *this = Mem_Alloc(sizeof(Char_GF));
@@ -204,12 +192,15 @@ static Character *Char_GF_New(fixed_t x, fixed_t y)
 	}
 	
 	//Initialize character
+	this->parallax = parallax;
+	this->tutorial = arc_tut != NULL;
+	
 	this->character.tick = Char_GF_Tick;
 	this->character.set_anim = Char_GF_SetAnim;
 	this->character.free = Char_GF_Free;
 	
 	Animatable_Init(&this->character.animatable, char_gf_anim);
-	Character_Init((Character*)this, x, y);
+	Character_Init((Character*)this, sizeof(*this), x, y);
 	
 	//Set character information
 	this->character.spec = 0;
@@ -228,36 +219,37 @@ static Character *Char_GF_New(fixed_t x, fixed_t y)
 		"gf2.tim", //GF_ArcMain_GF2
 		NULL
 	};
+	IO_Data arc_main = Resident_Get(Resident_GF);
 	IO_Data *arc_ptr = this->arc_ptr;
 	for (; *pathp != NULL; pathp++)
-		*arc_ptr++ = Archive_Find((IO_Data)char_gf_arc_main, *pathp);
+		*arc_ptr++ = Archive_Find(arc_main, *pathp);
 	
 	//Load scene specific art
 	switch (stage.stage_id)
 	{
-		#ifdef CHAR_GF_TUTORIAL
-			case StageId_1_4: //Tutorial
-			{
-				const char **pathp = (const char *[]){
-					"tut0.tim", //GF_ArcScene_0
-					"tut1.tim", //GF_ArcScene_1
-					NULL
-				};
-				IO_Data *arc_ptr = &this->arc_ptr[GF_ArcScene_0];
-				for (; *pathp != NULL; pathp++)
-					*arc_ptr++ = Archive_Find((IO_Data)char_gf_arc_tut, *pathp);
+		case StageId_1_4: //Tutorial
+		{
+			if (arc_tut == NULL)
 				break;
-			}
-		#endif
+			const char **pathp = (const char *[]){
+				"tut0.tim", //GF_ArcScene_0
+				"tut1.tim", //GF_ArcScene_1
+				NULL
+			};
+			IO_Data *arc_ptr = &this->arc_ptr[GF_ArcScene_0];
+			for (; *pathp != NULL; pathp++)
+				*arc_ptr++ = Archive_Find(arc_tut, *pathp);
+			break;
+		}
 		default:
 			break;
 	}
 	
 	//Initialize render state
-	this->tex_id = this->frame = 0xFF;
+	this->character.tex_id = this->character.frame = 0xFF;
 	
 	//Initialize speaker
-	Speaker_Init(&this->speaker);
+	Speaker_Init(&this->speaker, Archive_Find(arc_main, "speaker.tim"));
 	
 	return (Character*)this;
 }
@@ -0,0 +1,16 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#ifndef PSXF_GUARD_GF_H
+#define PSXF_GUARD_GF_H
+
+#include "../character.h"
+
+//GF character functions, art is resident
+//arc_tut has the tutorial singing art, or is NULL if GF only dances
+Character *Char_GF_New(fixed_t x, fixed_t y, fixed_t parallax, IO_Data arc_tut);
+
+#endif
@@ -4,40 +4,28 @@
   file, You can obtain one at http://mozilla.org/MPL/2.0/.
 */
 
-#include "boot/io.h"
-#include "boot/stage.h"
-#include "boot/timer.h"
+#include "speaker.h"
 
-//Speaker structure
-typedef struct
-{
-	//Speaker state
-	Gfx_Tex tex;
-	fixed_t bump;
-} Speaker;
-
-//Speaker assets
-static const u8 speaker_tim[] = {
-	#include "iso/gf/speaker.tim.h"
-};
+#include "../stage.h"
+#include "../timer.h"
 
 //Speaker functions
-static void Speaker_Init(Speaker *this)
+void Speaker_Init(Speaker *this, IO_Data tim)
 {
 	//Initialize speaker state
 	this->bump = 0;
 	
 	//Load speaker graphics
-	Gfx_LoadTex(&this->tex, (IO_Data)speaker_tim, 0);
+	Gfx_LoadTex(&this->tex, tim, 0);
 }
 
-static void Speaker_Bump(Speaker *this)
+void Speaker_Bump(Speaker *this)
 {
 	//Set bump
 	this->bump = FIXED_DEC(4,1) / 24 - 1;
 }
 
-static void Speaker_Tick(Speaker *this, fixed_t x, fixed_t y, fixed_t parallax)
+void Speaker_Tick(Speaker *this, fixed_t x, fixed_t y, fixed_t parallax)
 {
 	//Get frame to use according to bump
 	u8 frame;
@@ -0,0 +1,89 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "chart.h"
+
+//Chart functions
+u32 Chart_ReadVarint(const u8 **p)
+{
+	//Read 7 bits at a time until the continuation bit is clear
+	u32 value = 0;
+	u8 shift = 0, byte;
+	do
+	{
+		byte = *(*p)++;
+		value |= (u32)(byte & 0x7F) << shift;
+		shift += 7;
+	} while (byte & 0x80);
+	return value;
+}
+
+Note *Chart_ExpandHeads(Note *note, Note *note_end, const u8 *head_p, u16 num_heads)
+{
+	//Expand note heads, interleaving the sustain pieces they start
+	struct
+	{
+		u16 pos, type, left;
+	} sustain[CHART_SUSTAIN_MAX];
+	u8 sustains = 0;
+
+	u16 head_pos = 0, head_type = 0, head_len = 0;
+	boolean head_valid = false;
+
+	for (; note < note_end; note++)
+	{
+		//Read next head
+		if (!head_valid && num_heads != 0)
+		{
+			head_pos += Chart_ReadVarint(&head_p);
+			head_type = *head_p++;
+			head_len = (head_type & NOTE_FLAG_SUSTAIN_END) ? Chart_ReadVarint(&head_p) : 0;
+			head_valid = true;
+			num_heads--;
+		}
+
+		//Get earliest pending sustain piece
+		u8 sus_i = 0xFF;
+		for (u8 i = 0; i < sustains; i++)
+			if (sus_i == 0xFF || sustain[i].pos < sustain[sus_i].pos)
+				sus_i = i;
+
+		if (head_valid && (sus_i == 0xFF || head_pos <= sustain[sus_i].pos))
+		{
+			//Push head and start its sustain
+			note->pos = head_pos;
+			note->type = head_type;
+			if (head_len != 0 && sustains < CHART_SUSTAIN_MAX)
+			{
+				sustain[sustains].pos = head_pos + 12;
+				sustain[sustains].type = head_type | NOTE_FLAG_SUSTAIN;
+				sustain[sustains].left = head_len;
+				sustains++;
+			}
+			head_valid = false;
+		}
+		else if (sus_i != 0xFF)
+		{
+			//Push sustain piece, only the last one keeps the end flag
+			note->pos = sustain[sus_i].pos;
+			note->type = sustain[sus_i].type;
+			if (--sustain[sus_i].left == 0)
+			{
+				sustain[sus_i] = sustain[--sustains];
+			}
+			else
+			{
+				note->type &= ~NOTE_FLAG_SUSTAIN_END;
+				sustain[sus_i].pos += 12;
+			}
+		}
+		else
+		{
+			break;
+		}
+	}
+	return note;
+}
@@ -0,0 +1,21 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#ifndef PSXF_GUARD_CHART_H
+#define PSXF_GUARD_CHART_H
+
+#include "psx.h"
+
+#include "stage.h"
+
+//Chart constants
+#define CHART_SUSTAIN_MAX 16 //Maximum overlapping sustains in a chart, must match funkinchtpak
+
+//Chart functions
+u32 Chart_ReadVarint(const u8 **p);
+Note *Chart_ExpandHeads(Note *note, Note *note_end, const u8 *head_p, u16 num_heads);
+
+#endif
@@ -33,6 +33,42 @@ typedef struct
 #define FIXED_MUL(x, y) ((fixed_t)(((s64)(x) * (y)) >> FIXED_SHIFT))
 #define FIXED_DIV(x, y) ((fixed_t)(((s32)(x) * FIXED_UNIT) / (y)))
 
+//32-bit multiplies
+//FIXED_MUL32 needs the whole product to fit in 32 bits, Fixed_Mul only needs the result to
+#define FIXED_HILO(hi, lo) ((fixed_t)(((u32)(lo) >> FIXED_SHIFT) | ((u32)(hi) << (32 - FIXED_SHIFT))))
+
+#ifdef PSXF_DEBUG
+	//Checked versions report the file and line of the multiply that overflowed
+	fixed_t Fixed_CheckMul32(fixed_t x, fixed_t y, const char *file, int line);
+	fixed_t Fixed_CheckMul(fixed_t x, fixed_t y, const char *file, int line);
+	#define FIXED_MUL32(x, y) Fixed_CheckMul32(x, y, __FILE__, __LINE__)
+	#define Fixed_Mul(x, y) Fixed_CheckMul(x, y, __FILE__, __LINE__)
+#else
+	#define FIXED_MUL32(x, y) ((fixed_t)((s32)(x) * (s32)(y)) >> FIXED_SHIFT)
+	
+	static inline fixed_t Fixed_Mul(fixed_t x, fixed_t y)
+	{
+		#ifdef PSXF_PC
+			return FIXED_MUL(x, y);
+		#else
+			//Use the 64-bit product in hi/lo directly rather than going through s64
+			s32 hi;
+			u32 lo;
+			__asm__(
+				"mult %2, %3\n"
+				"mflo %1\n"
+				"mfhi %0\n"
+				"nop\n" //hi/lo must not be written for two instructions after a read
+				"nop"
+				: "=r" (hi), "=r" (lo)
+				: "r" (x), "r" (y)
+				: "hi", "lo"
+			);
+			return FIXED_HILO(hi, lo);
+		#endif
+	}
+#endif
+
 #define FIXEDU_DEC(d, f) (((fixedu_t)(d) * FIXED_UNIT) / (f))
 
 #define FIXEDU_MUL(x, y) ((fixedu_t)(((u64)(x) * (y)) >> FIXED_SHIFT))
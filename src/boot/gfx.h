@@ -51,6 +51,8 @@ void Gfx_LoadTex(Gfx_Tex *tex, IO_Data data, Gfx_LoadTex_Flag flag);
 
 void Gfx_DrawRect(const RECT *rect, u8 r, u8 g, u8 b);
 void Gfx_BlendRect(const RECT *rect, u8 r, u8 g, u8 b, u8 mode);
+void Gfx_DrawGradientRect(const RECT *rect, u8 r0, u8 g0, u8 b0, u8 r1, u8 g1, u8 b1);
+void Gfx_BlendGradientRect(const RECT *rect, u8 r0, u8 g0, u8 b0, u8 r1, u8 g1, u8 b1, u8 mode);
 void Gfx_BlitTexCol(Gfx_Tex *tex, const RECT *src, s32 x, s32 y, u8 r, u8 g, u8 b);
 void Gfx_BlitTex(Gfx_Tex *tex, const RECT *src, s32 x, s32 y);
 void Gfx_DrawTexCol(Gfx_Tex *tex, const RECT *src, const RECT *dst, u8 r, u8 g, u8 b);
@@ -61,4 +63,45 @@ void Gfx_DrawTexArb(Gfx_Tex *tex, const RECT *src, const POINT *p0, const POINT
 void Gfx_BlendTexArbCol(Gfx_Tex *tex, const RECT *src, const POINT *p0, const POINT *p1, const POINT *p2, const POINT *p3, u8 r, u8 g, u8 b, u8 mode);
 void Gfx_BlendTexArb(Gfx_Tex *tex, const RECT *src, const POINT *p0, const POINT *p1, const POINT *p2, const POINT *p3, u8 mode);
 
+//VRAM backup, while active every area Gfx_LoadTex is about to overwrite is saved to RAM
+//Gfx_BackupRestore puts it back (returning false if something couldn't be saved), Gfx_BackupEnd discards it
+void Gfx_BackupBegin(void);
+boolean Gfx_BackupRestore(void);
+void Gfx_BackupEnd(void);
+
+//Fill-rate statistics, pixels covered per texture depth and blend mode and per layer (set by the caller)
+//The PSX estimates them from primitive sizes as they're submitted, the host rasteriser counts them exactly
+#if defined(PSXF_DEBUG) || defined(PSXF_PC)
+	#define PSXF_FILL
+#endif
+
+#define GFX_FILL_DEPTHS 4 //4bpp, 8bpp, 15bpp, then untextured
+#define GFX_FILL_FLAT   3
+#define GFX_FILL_BLENDS 5 //Opaque, then semi-transparency modes 0-3
+#define GFX_FILL_LAYERS 10
+
+typedef struct
+{
+	u32 pixels[GFX_FILL_DEPTHS][GFX_FILL_BLENDS];
+	u32 layer[GFX_FILL_LAYERS];
+} Gfx_FillStats;
+
+#ifdef PSXF_FILL
+	void Gfx_SetFillLayer(u8 layer);
+	void Gfx_GetFillStats(Gfx_FillStats *stats); //Last frame's
+	
+	//Screen areas the PSX estimates with, clipped to the screen (gfxfill.c)
+	u32 Gfx_FillRectArea(s32 x, s32 y, s32 w, s32 h);
+	u32 Gfx_FillQuadArea(const POINT *p0, const POINT *p1, const POINT *p2, const POINT *p3);
+#else
+	#define Gfx_SetFillLayer(layer)
+#endif
+
+#ifdef PSXF_PC
+	//Host rasteriser, Gfx_WriteFrame saves the last drawn frame as a PNG and
+	//Gfx_GetPixels returns how many pixels it touched
+	boolean Gfx_WriteFrame(const char *path);
+	u32 Gfx_GetPixels(void);
+#endif
+
 #endif
@@ -0,0 +1,101 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "gfx.h"
+
+#ifdef PSXF_FILL
+
+//Fill-rate estimates, on-screen areas of primitives as submitted
+u32 Gfx_FillRectArea(s32 x, s32 y, s32 w, s32 h)
+{
+	//Flipped rects cover the same area, then clip to the screen
+	if (w < 0)
+	{
+		x += w;
+		w = -w;
+	}
+	if (h < 0)
+	{
+		y += h;
+		h = -h;
+	}
+	s32 x1 = x + w, y1 = y + h;
+	if (x < 0)
+		x = 0;
+	if (y < 0)
+		y = 0;
+	if (x1 > SCREEN_WIDTH)
+		x1 = SCREEN_WIDTH;
+	if (y1 > SCREEN_HEIGHT)
+		y1 = SCREEN_HEIGHT;
+	if (x1 <= x || y1 <= y)
+		return 0;
+	return (x1 - x) * (y1 - y);
+}
+
+#define GFX_FILL_CLIP 20 //Each edge adds at most half again to a twisted quad, 4 6 9 13 19
+#define GFX_FILL_SUB  4  //Sub-pixel bits for clipped points, rounding them to pixels skews long edges
+
+static s32 Gfx_FillInside(u8 edge, s32 x, s32 y)
+{
+	//How far inside the given screen edge a point is
+	switch (edge)
+	{
+		case 0:
+			return x;
+		case 1:
+			return (SCREEN_WIDTH << GFX_FILL_SUB) - x;
+		case 2:
+			return y;
+		default:
+			return (SCREEN_HEIGHT << GFX_FILL_SUB) - y;
+	}
+}
+
+u32 Gfx_FillQuadArea(const POINT *p0, const POINT *p1, const POINT *p2, const POINT *p3)
+{
+	//Clip 0-1-3-2 to the screen one edge at a time
+	s32 px[2][GFX_FILL_CLIP] = {{p0->x << GFX_FILL_SUB, p1->x << GFX_FILL_SUB, p3->x << GFX_FILL_SUB, p2->x << GFX_FILL_SUB}};
+	s32 py[2][GFX_FILL_CLIP] = {{p0->y << GFX_FILL_SUB, p1->y << GFX_FILL_SUB, p3->y << GFX_FILL_SUB, p2->y << GFX_FILL_SUB}};
+	u8 n = 4;
+	for (u8 edge = 0; edge < 4; edge++)
+	{
+		const s32 *ix = px[edge & 1], *iy = py[edge & 1];
+		s32 *ox = px[(edge & 1) ^ 1], *oy = py[(edge & 1) ^ 1];
+		u8 m = 0;
+		for (u8 i = 0; i < n; i++)
+		{
+			u8 j = (i + 1 == n) ? 0 : (i + 1);
+			s32 di = Gfx_FillInside(edge, ix[i], iy[i]);
+			s32 dj = Gfx_FillInside(edge, ix[j], iy[j]);
+			if (di >= 0)
+			{
+				ox[m] = ix[i];
+				oy[m++] = iy[i];
+			}
+			if ((di < 0) != (dj < 0))
+			{
+				ox[m] = ix[i] + (s32)((s64)(ix[j] - ix[i]) * di / (di - dj));
+				oy[m++] = iy[i] + (s32)((s64)(iy[j] - iy[i]) * di / (di - dj));
+			}
+		}
+		if ((n = m) < 3)
+			return 0;
+	}
+	
+	//Shoelace over what's left, on screen so it can't overflow
+	s32 area = 0;
+	for (u8 i = 0; i < n; i++)
+	{
+		u8 j = (i + 1 == n) ? 0 : (i + 1);
+		area += px[0][i] * py[0][j] - px[0][j] * py[0][i];
+	}
+	if (area < 0)
+		area = -area;
+	return area >> (1 + GFX_FILL_SUB * 2);
+}
+
+#endif
@@ -0,0 +1,67 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "log.h"
+
+#if PSXF_LOG_LEVEL > LOG_LEVEL_NONE
+
+#include <stdarg.h>
+
+//Log state
+static const char *log_level_tag[] = {
+	"",
+	"ERR",
+	"WRN",
+	"INF",
+	"TRC",
+};
+
+#ifndef PSXF_LOG_TTY
+static char log_ring[LOG_LINES][LOG_LINE_LEN];
+static u8 log_head, log_count;
+#endif
+
+//Log functions
+void Log_Write(u8 level, u8 cat, const char *format, ...)
+{
+	(void)cat;
+
+	//Format message
+	char buf[0x100];
+	va_list args;
+	va_start(args, format);
+	vsprintf(buf, format, args);
+	va_end(args);
+
+	#ifdef PSXF_LOG_TTY
+		printf("[%s] %s\n", log_level_tag[level], buf);
+	#else
+		//Copy into the ring, dropping the oldest line
+		char *line = log_ring[log_head];
+		sprintf(line, "%s ", log_level_tag[level]);
+		strncpy(line + 4, buf, LOG_LINE_LEN - 5);
+		line[LOG_LINE_LEN - 1] = '\0';
+
+		log_head = (log_head + 1) % LOG_LINES;
+		if (log_count < LOG_LINES)
+			log_count++;
+	#endif
+}
+
+const char *Log_GetLine(u8 i)
+{
+	#ifdef PSXF_LOG_TTY
+		(void)i;
+		return NULL;
+	#else
+		//0 is the newest line
+		if (i >= log_count)
+			return NULL;
+		return log_ring[(log_head + LOG_LINES - 1 - i) % LOG_LINES];
+	#endif
+}
+
+#endif
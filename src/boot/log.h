@@ -0,0 +1,59 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#ifndef PSXF_GUARD_LOG_H
+#define PSXF_GUARD_LOG_H
+
+#include "psx.h"
+
+//Log levels, anything above PSXF_LOG_LEVEL is removed by the preprocessor
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_TRACE 4
+
+#ifndef PSXF_LOG_LEVEL
+	#ifdef PSXF_DEBUG
+		#define PSXF_LOG_LEVEL LOG_LEVEL_INFO
+	#else
+		#define PSXF_LOG_LEVEL LOG_LEVEL_NONE
+	#endif
+#endif
+
+//Log categories, anything outside of PSXF_LOG_CATS is folded away by the compiler
+#define LOG_IO    (1 << 0)
+#define LOG_AUDIO (1 << 1)
+#define LOG_STAGE (1 << 2)
+#define LOG_MENU  (1 << 3)
+#define LOG_MOVIE (1 << 4)
+
+#ifndef PSXF_LOG_CATS
+	#define PSXF_LOG_CATS 0xFF
+#endif
+
+//Log ring, debug builds keep the last lines here unless PSXF_LOG_TTY sends them to the TTY
+#define LOG_LINES    16
+#define LOG_LINE_LEN 64
+
+//Log functions
+#if PSXF_LOG_LEVEL > LOG_LEVEL_NONE
+	void Log_Write(u8 level, u8 cat, const char *format, ...);
+	const char *Log_GetLine(u8 i);
+
+	#define LOG_AT(level, cat, ...) do { if ((level) <= PSXF_LOG_LEVEL && ((cat) & PSXF_LOG_CATS)) Log_Write(level, cat, __VA_ARGS__); } while (0)
+#else
+	#define Log_GetLine(i) ((const char*)NULL)
+
+	#define LOG_AT(level, cat, ...) do {} while (0)
+#endif
+
+#define LOG_ERROR(cat, ...) LOG_AT(LOG_LEVEL_ERROR, cat, __VA_ARGS__)
+#define LOG_WARN(cat, ...)  LOG_AT(LOG_LEVEL_WARN,  cat, __VA_ARGS__)
+#define LOG_INFO(cat, ...)  LOG_AT(LOG_LEVEL_INFO,  cat, __VA_ARGS__)
+#define LOG_TRACE(cat, ...) LOG_AT(LOG_LEVEL_TRACE, cat, __VA_ARGS__)
+
+#endif
@@ -12,13 +12,17 @@
 #include "audio.h"
 #include "pad.h"
 #include "network.h"
+#include "log.h"
+#include "profiler.h"
 
 #include "menu/menu.h"
 #include "stage.h"
 #include "movie.h"
 
 //Memory implementation
-#define MEM_STAT //This will enable the Mem_GetStat function which returns information about available memory in the heap
+#ifdef PSXF_DEBUG
+	#define MEM_STAT //This will enable the Mem_GetStat function which returns information about available memory in the heap
+#endif
 
 #define MEM_IMPLEMENTATION
 #include "mem.h"
@@ -39,15 +43,101 @@ void ErrorLock(void)
 			exit(1);
 		#else
 			FntPrint("A fatal error has occured\n~c700%s\n", error_msg);
+			
+			//Show what led up to the error
+			for (u8 i = 0; i < 8; i++)
+			{
+				const char *line = Log_GetLine(i);
+				if (line == NULL)
+					break;
+				FntPrint("~c777%s\n", line);
+			}
 			Gfx_Flip();
 		#endif
 	}
 }
 
-//Overlay interface
 #ifndef PSXF_PC
+extern u8 __heap_start, __sp;
+
+//The stack grows down from __sp, resident data and the heap are kept below this much of it
+#define STACK_RESERVE 0x4000
+#define STACK_BOTTOM  (&__sp - STACK_RESERVE)
+
+#ifdef PSXF_DEBUG
+	#define STACK_GUARD 0x4B415453 //Written at the bottom of the stack reserve and checked every frame
+#endif
+#endif
 
-extern u8 __heap_start, __ram_top;
+//Resident data interface
+static IO_Data resident_data[Resident_Max];
+static u8 resident_loaded;
+
+#ifndef PSXF_PC
+static u8 *resident_top = STACK_BOTTOM;
+static CdlFILE resident_file[Resident_Max];
+static u8 resident_found;
+#endif
+
+void Resident_Load(u8 residents)
+{
+	static const char *resident_path[Resident_Max] = {
+		"\\CHAR\\BF.ARC;1", //Resident_BF
+		"\\CHAR\\GF.ARC;1", //Resident_GF
+	};
+	
+	#ifdef PSXF_PC
+		//Host memory isn't short, keep everything that was ever loaded
+		for (int i = 0; i < Resident_Max; i++)
+		{
+			if ((residents & RESIDENT_FLAG(i)) && !(resident_loaded & RESIDENT_FLAG(i)))
+				resident_data[i] = IO_Read(resident_path[i]);
+		}
+		resident_loaded |= residents;
+	#else
+		//Stack files down from the stack reserve, last first, so a set keeps its addresses when earlier files are dropped
+		u8 *data = STACK_BOTTOM;
+		for (int i = Resident_Max - 1; i >= 0; i--)
+		{
+			if (!(residents & RESIDENT_FLAG(i)))
+			{
+				resident_data[i] = NULL;
+				continue;
+			}
+			
+			//Find file, once per session
+			if (!(resident_found & RESIDENT_FLAG(i)))
+			{
+				IO_FindFile(&resident_file[i], resident_path[i]);
+				resident_found |= RESIDENT_FLAG(i);
+			}
+			size_t sects = (resident_file[i].size + 0x7FF) >> 11;
+			data -= sects << 11;
+			
+			//Read file unless it's already there
+			if ((resident_loaded & RESIDENT_FLAG(i)) && resident_data[i] == (IO_Data)data)
+				continue;
+			
+			CdControl(CdlSetloc, (u8*)&resident_file[i].pos, NULL);
+			CdRead(sects, (IO_Data)data, CdlModeSpeed);
+			CdReadSync(0, NULL);
+			
+			resident_data[i] = (IO_Data)data;
+		}
+		resident_loaded = residents;
+		
+		//The heap ends where the resident data starts
+		resident_top = data;
+	#endif
+}
+
+IO_Data Resident_Get(Resident resident)
+{
+	return resident_data[resident];
+}
+
+//Overlay interface
+#ifndef PSXF_PC
 
 static int overlay_pos, overlay_datapos;
 static u16 *overlay_sizes, *overlay_sizestart;
@@ -81,8 +171,8 @@ void Overlay_Load(const char *path)
 	
 	overlay_pos += overlay_sectsleft;
 	
-	//Initialize memory heap at end of overlay data
-	Mem_Init(&__heap_start + overlay_size, &__ram_top - &__heap_start - overlay_size);
+	//Initialize memory heap between the end of overlay data and the resident data
+	Mem_Init(&__heap_start + overlay_size, resident_top - &__heap_start - overlay_size);
 	
 	//Initialize overlay data reading
 	overlay_datapos = overlay_pos;
@@ -98,25 +188,40 @@ void Overlay_DataInit(void)
 	overlay_pos = overlay_datapos;
 }
 
-IO_Data Overlay_DataRead(void)
+static IO_Data Overlay_DataReadPos(int pos, u16 size)
 {
 	//Allocate buffer
-	u16 size = *overlay_sizes++;
 	IO_Data overlay_data = Mem_Alloc(size << 11);
 	
 	//Read data to overlay data buffer according to sizes
-	CdlLOC pos;
+	CdlLOC loc;
 	
-	CdIntToPos(overlay_pos, &pos);
-	CdControl(CdlSetloc, (u8*)&pos, NULL);
+	CdIntToPos(pos, &loc);
+	CdControl(CdlSetloc, (u8*)&loc, NULL);
 	
 	CdRead(size, overlay_data, CdlModeSpeed);
 	CdReadSync(0, NULL);
 	
+	return overlay_data;
+}
+
+IO_Data Overlay_DataRead(void)
+{
+	u16 size = *overlay_sizes++;
+	IO_Data overlay_data = Overlay_DataReadPos(overlay_pos, size);
 	overlay_pos += size;
 	return overlay_data;
 }
 
+IO_Data Overlay_DataReadAt(u16 index)
+{
+	//Find position of the requested file without touching the read state
+	int pos = overlay_datapos;
+	for (u16 i = 0; i < index; i++)
+		pos += overlay_sizestart[i];
+	return Overlay_DataReadPos(pos, overlay_sizestart[index]);
+}
+
 #endif
 
 //Entry point
@@ -129,6 +234,10 @@ int main(int argc, char **argv)
 	//Initialize system
 	PSX_Init();
 	
+	#if defined(PSXF_DEBUG) && !defined(PSXF_PC)
+		*((u32*)STACK_BOTTOM) = STACK_GUARD;
+	#endif
+	
 	IO_Init();
 	Audio_Init();
 	Gfx_Init();
@@ -136,6 +245,7 @@ int main(int argc, char **argv)
 	Network_Init();
 	
 	Timer_Init();
+	Profiler_Init();
 	
 	//Start game
 	Menu_Load(MenuPage_Opening);
@@ -144,8 +254,18 @@ int main(int argc, char **argv)
 	while (PSX_Running())
 	{
 		//Prepare frame
+		Profiler_Frame();
 		Timer_Tick();
+		
+		Profiler_Begin(ProfScope_Pad);
 		Pad_Update();
+		Profiler_End(ProfScope_Pad);
+		
+		#ifdef PSXF_DEBUG
+			//Toggle profiler
+			if (pad_state.press & PAD_SELECT)
+				Profiler_Toggle();
+		#endif
 		
 		#ifdef MEM_STAT
 			//Memory stats
@@ -156,6 +276,7 @@ int main(int argc, char **argv)
 		
 		//Tick and draw game
 		Network_Process();
+		Profiler_Begin(ProfScope_Tick);
 		switch (gameloop)
 		{
 			case GameLoop_Menu:
@@ -168,12 +289,23 @@ int main(int argc, char **argv)
 				Movie_Tick();
 				break;
 		}
+		Profiler_End(ProfScope_Tick);
+		
+		#if defined(PSXF_DEBUG) && !defined(PSXF_PC)
+			//Make sure the stack stayed out of the resident data
+			if (*((u32*)STACK_BOTTOM) != STACK_GUARD)
+			{
+				sprintf(error_msg, "[main] Stack overflowed its 0x%X byte reserve", STACK_RESERVE);
+				ErrorLock();
+			}
+		#endif
 		
 		//Flip gfx buffers
 		Gfx_Flip();
 	}
 	
 	//Deinitialize system
+	Profiler_Quit();
 	Network_Quit();
 	Pad_Quit();
 	Gfx_Quit();
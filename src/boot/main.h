@@ -25,9 +25,25 @@ extern GameLoop gameloop;
 extern char error_msg[0x200];
 void ErrorLock(void);
 
+//Resident data interface, kept loaded across overlays
+typedef enum
+{
+	Resident_BF, //bf/main.arc
+	Resident_GF, //gf/main.arc
+	
+	Resident_Max,
+} Resident;
+
+#define RESIDENT_FLAG(resident) (1 << (resident))
+#define RESIDENT_ALL ((1 << Resident_Max) - 1)
+
+void Resident_Load(u8 residents);
+IO_Data Resident_Get(Resident resident);
+
 //Overlay interface
 void Overlay_Load(const char *path);
 void Overlay_DataInit(void);
 IO_Data Overlay_DataRead(void);
+IO_Data Overlay_DataReadAt(u16 index);
 
 #endif
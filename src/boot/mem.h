@@ -25,8 +25,16 @@
 #undef MEM_STAT /* Control unsupported */
 
 #define Mem_Init(x,y)
-#define Mem_Alloc malloc
-#define Mem_Free free
+#ifdef PSXF_TRACE
+	/* Trace builds log every allocation, see profiler.h */
+	void *Profiler_TraceAlloc(size_t size);
+	void Profiler_TraceFree(void *ptr);
+	#define Mem_Alloc Profiler_TraceAlloc
+	#define Mem_Free Profiler_TraceFree
+#else
+	#define Mem_Alloc malloc
+	#define Mem_Free free
+#endif
 
 #else
 
@@ -13,7 +13,8 @@ void Menu_Load2(MenuPage page);
 
 void Menu_Load(MenuPage page)
 {
-	//Load overlay then call load function
+	//Load overlay then call load function, the menu shows both BF and GF
+	Resident_Load(RESIDENT_ALL);
 	Overlay_Load("\\MENU\\MENU.EXE;1");
 	Menu_Load2(page);
 	gameloop = GameLoop_Menu;
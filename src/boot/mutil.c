@@ -7,6 +7,11 @@
 #include "mutil.h"
 
 #include "timer.h"
+#include "gfx.h"
+
+#ifdef PSXF_DEBUG
+	#include "main.h"
+#endif
 
 //Sine table
 static const s16 sine_table[0x140] = {
@@ -50,3 +55,40 @@ void MUtil_RotatePoint(POINT *p, s16 s, s16 c)
 	p->x = ((px * c) >> 8) - ((py * s) >> 8);
 	p->y = ((px * s) >> 8) + ((py * c) >> 8);
 }
+
+void MUtil_ZoomPoints(const POINT_FIXED *in, POINT *out, size_t n, fixed_t zoom)
+{
+	//Snap to the GTE's sub-pixels first so this lands on the same pixels as its transform
+	for (; n != 0; n--, in++, out++)
+	{
+		out->x = SCREEN_WIDTH2 + (Fixed_Mul(in->x >> (FIXED_SHIFT - MUTIL_ZOOM_SUB), zoom) >> MUTIL_ZOOM_SUB);
+		out->y = SCREEN_HEIGHT2 + (Fixed_Mul(in->y >> (FIXED_SHIFT - MUTIL_ZOOM_SUB), zoom) >> MUTIL_ZOOM_SUB);
+	}
+}
+
+//Fixed point range checks
+#ifdef PSXF_DEBUG
+fixed_t Fixed_CheckMul32(fixed_t x, fixed_t y, const char *file, int line)
+{
+	//Product must fit in 32 bits
+	s64 product = (s64)x * y;
+	if (product != (s32)product)
+	{
+		sprintf(error_msg, "[FIXED_MUL32] %s:%d overflowed (%d * %d)", file, line, (int)x, (int)y);
+		ErrorLock();
+	}
+	return (fixed_t)product >> FIXED_SHIFT;
+}
+
+fixed_t Fixed_CheckMul(fixed_t x, fixed_t y, const char *file, int line)
+{
+	//Result must fit in 32 bits
+	s64 result = ((s64)x * y) >> FIXED_SHIFT;
+	if (result != (fixed_t)result)
+	{
+		sprintf(error_msg, "[Fixed_Mul] %s:%d overflowed (%d * %d)", file, line, (int)x, (int)y);
+		ErrorLock();
+	}
+	return (fixed_t)result;
+}
+#endif
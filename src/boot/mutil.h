@@ -11,10 +11,14 @@
 
 #include "fixed.h"
 
+//Math utility constants
+#define MUTIL_ZOOM_SUB 2 //Sub-pixel bits points are snapped to before zooming, as many as the GTE path keeps
+
 //Math utility functions
 s16 MUtil_Sin(u8 x);
 s16 MUtil_Cos(u8 x);
 void MUtil_RotatePoint(POINT *p, s16 s, s16 c);
+void MUtil_ZoomPoints(const POINT_FIXED *in, POINT *out, size_t n, fixed_t zoom);
 fixed_t MUtil_Pull(fixed_t a, fixed_t b, fixed_t t);
 
 #endif
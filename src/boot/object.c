@@ -7,6 +7,7 @@
 #include "object.h"
 
 #include "mem.h"
+#include "profiler.h"
 
 //Object functions
 void ObjectList_Add(ObjectList *list, Object *obj)
@@ -35,6 +36,8 @@ void ObjectList_Remove(ObjectList *list, Object *obj)
 
 void ObjectList_Tick(ObjectList *list)
 {
+	Profiler_Begin(ProfScope_Objects);
+	
 	//Tick all contained objects
 	for (Object *obj = *list; obj != NULL;)
 	{
@@ -44,6 +47,8 @@ void ObjectList_Tick(ObjectList *list)
 			ObjectList_Remove(list, obj);
 		obj = next;
 	}
+	
+	Profiler_End(ProfScope_Objects);
 }
 
 void ObjectList_Free(ObjectList *list)
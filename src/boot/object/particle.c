@@ -0,0 +1,114 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "particle.h"
+
+#include "../stage.h"
+#include "../random.h"
+#include "../mutil.h"
+
+//Particle system functions
+void Particle_Clear(ParticleSystem *this)
+{
+	this->count = 0;
+}
+
+void Particle_EmitSplash(ParticleSystem *this, fixed_t x, fixed_t y, u8 colour)
+{
+	//Drop the splash if the system is full
+	if (this->count >= PARTICLE_MAX)
+		return;
+	u8 i = this->count++;
+	
+	//Initialize position
+	u8 angle = Random8();
+	fixed_t speed = RandomRange(FIXED_DEC(35,10), FIXED_DEC(45,10));
+	this->xsp[i] = ((this->cos[i] = MUtil_Cos(angle)) * speed) >> 8;
+	this->ysp[i] = ((this->sin[i] = MUtil_Sin(angle)) * speed) >> 8;
+	this->size[i] = 0;
+	
+	this->x[i] = x + this->xsp[i];
+	this->y[i] = y + this->ysp[i];
+	
+	this->colour[i] = colour;
+}
+
+void Particle_Tick(ParticleSystem *this)
+{
+	StageQuad quad[STAGE_BATCH_QUADS];
+	size_t quads = 0;
+	
+	for (u8 i = 0; i < this->count;)
+	{
+		//Move
+		fixed_t size = this->size[i];
+		fixed_t x = this->x[i], y = this->y[i];
+		fixed_t xsp = this->xsp[i], ysp = this->ysp[i];
+		
+		fixed_t lx = x - xsp * (2 + ((size * 4) >> FIXED_SHIFT));
+		fixed_t ly = y - ysp * (2 + ((size * 4) >> FIXED_SHIFT));
+		this->x[i] = x + xsp;
+		this->y[i] = y + ysp;
+		this->xsp[i] = xsp * 5 / 6;
+		this->ysp[i] = ysp * 5 / 6;
+		x += xsp;
+		y += ysp;
+		
+		//Scale down
+		fixed_t scale = FIXED_MUL(FIXED_UNIT - FIXED_MUL(size, size), FIXED_DEC(8,10));
+		this->size[i] = size + FIXED_UNIT / 25;
+		
+		//Queue plubbie
+		StageQuad *plub = &quad[quads++];
+		plub->src.x = 120 + (this->colour[i] << 2);
+		plub->src.y = 224;
+		plub->src.w = plub->src.h = 4;
+		plub->p[0].x = plub->p[2].x = x - (scale << 2);
+		plub->p[1].x = plub->p[3].x = x + (scale << 2);
+		plub->p[0].y = plub->p[1].y = y - (scale << 2);
+		plub->p[2].y = plub->p[3].y = y + (scale << 2);
+		
+		//Queue tail
+		fixed_t tx =  this->sin[i] * scale >> 6;
+		fixed_t ty = -this->cos[i] * scale >> 6;
+		
+		StageQuad *tail = &quad[quads++];
+		tail->src = plub->src;
+		tail->src.y = 228;
+		tail->p[0].x = x - tx;  tail->p[0].y = y - ty;
+		tail->p[1].x = x + tx;  tail->p[1].y = y + ty;
+		tail->p[2].x = lx - tx; tail->p[2].y = ly - ty;
+		tail->p[3].x = lx + tx; tail->p[3].y = ly + ty;
+		
+		if (quads == STAGE_BATCH_QUADS)
+		{
+			Stage_DrawQuadBatch(&stage.tex_hud0, quad, quads, stage.bump, 0x80, 0x80, 0x80, STAGE_QUAD_OPAQUE);
+			quads = 0;
+		}
+		
+		//Remove finished particles by moving the last one into their place
+		if (this->size[i] >= FIXED_UNIT)
+		{
+			u8 last = --this->count;
+			this->x[i] = this->x[last];
+			this->y[i] = this->y[last];
+			this->xsp[i] = this->xsp[last];
+			this->ysp[i] = this->ysp[last];
+			this->size[i] = this->size[last];
+			this->sin[i] = this->sin[last];
+			this->cos[i] = this->cos[last];
+			this->colour[i] = this->colour[last];
+		}
+		else
+		{
+			i++;
+		}
+	}
+	
+	//Draw remaining quads
+	if (quads != 0)
+		Stage_DrawQuadBatch(&stage.tex_hud0, quad, quads, stage.bump, 0x80, 0x80, 0x80, STAGE_QUAD_OPAQUE);
+}
@@ -0,0 +1,32 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#ifndef PSXF_GUARD_PARTICLE_H
+#define PSXF_GUARD_PARTICLE_H
+
+#include "../psx.h"
+#include "../fixed.h"
+
+//Particle system structure
+#define PARTICLE_MAX 48 //Enough for 16 SICKs' worth of splashes at once
+
+typedef struct
+{
+	//Particle state, stored per field so the tick loop walks each array in order
+	u8 count;
+	fixed_t x[PARTICLE_MAX], y[PARTICLE_MAX];
+	fixed_t xsp[PARTICLE_MAX], ysp[PARTICLE_MAX];
+	fixed_t size[PARTICLE_MAX];
+	s16 sin[PARTICLE_MAX], cos[PARTICLE_MAX];
+	u8 colour[PARTICLE_MAX];
+} ParticleSystem;
+
+//Particle system functions
+void Particle_Clear(ParticleSystem *this);
+void Particle_EmitSplash(ParticleSystem *this, fixed_t x, fixed_t y, u8 colour);
+void Particle_Tick(ParticleSystem *this);
+
+#endif
@@ -9,6 +9,8 @@
 
 #include "psx.h"
 
+#include "fixed.h"
+
 //Pad constants
 #define PAD_SELECT      1
 #define PAD_L3          2
@@ -28,11 +30,23 @@
 #define PAD_SQUARE      32768
 
 //Pad structure
+#define PAD_EVENTS 8
+
+typedef struct
+{
+	u16 press;
+	fixed_t age; //How long before this frame's timer tick the buttons were pressed
+} Pad_Event;
+
 typedef struct
 {
 	u16 held, press;
 	u8 left_x, left_y;
 	u8 right_x, right_y;
+	
+	//Presses sampled every VSync since the last update, oldest first
+	Pad_Event events[PAD_EVENTS];
+	u8 events_count;
 } Pad;
 
 extern Pad pad_state, pad_state_2;
@@ -0,0 +1,964 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+//Software rasteriser for the host build, it draws into an emulated 1024x512 VRAM
+//following the PSX GPU's rules so frames can be written out and compared
+
+#include "../gfx.h"
+
+#include "../mem.h"
+#include "../main.h"
+#include "../profiler.h"
+
+//Gfx constants
+#define VRAM_WIDTH  1024
+#define VRAM_HEIGHT 512
+
+#define GFX_PRIMS 4096
+
+//VRAM
+static u16 vram[VRAM_HEIGHT][VRAM_WIDTH];
+
+//Primitives, recorded during the frame and drawn by Gfx_Flip in reverse order like an ordering table
+typedef enum
+{
+	GfxPrim_F4,    //Flat quad
+	GfxPrim_G4,    //Gouraud quad
+	GfxPrim_FT4,   //Textured quad
+	GfxPrim_Sprt,  //Sprite, uses the current tpage
+	GfxPrim_TPage, //Tpage change
+} Gfx_PrimType;
+
+typedef struct
+{
+	RECT clip;
+	s32 ofs_x, ofs_y;
+	boolean isbg;
+	u8 r, g, b;
+} Gfx_Env;
+
+typedef struct
+{
+	u8 type;
+	boolean semi;
+	s16 x[4], y[4];
+	u8 u[4], v[4];
+	u8 r[4], g[4], b[4];
+	u16 tpage, clut;
+	s16 w, h;
+	u8 fill_layer;
+} Gfx_Prim;
+
+//Gfx state
+static Gfx_Env draw[2];
+static u8 db;
+
+static Gfx_Prim gfx_prim[GFX_PRIMS];
+static u16 gfx_prims;
+
+static u32 gfx_pixels, gfx_pixels_last; //Pixels touched this and last frame
+
+static Gfx_FillStats gfx_fill, gfx_fill_last;
+static u8 gfx_fill_layer;
+
+static RECT gfx_display; //Last drawn frame
+static u32 gfx_frame;
+
+//Rasteriser state
+static Gfx_Env gfx_env;
+static u16 gfx_tpage;
+
+#define GFX_BACKUP_MAX 8
+
+static struct
+{
+	RECT rect;
+	u16 *data;
+} gfx_backup[GFX_BACKUP_MAX];
+static u8 gfx_backups;
+static boolean gfx_backup_active, gfx_backup_lost;
+static u8 gfx_backup_clear[3];
+
+//GPU encodings, same as libgpu's
+static u16 Gfx_GetTPage(u8 tp, u8 abr, s32 x, s32 y)
+{
+	return ((tp & 0x3) << 7) | ((abr & 0x3) << 5) | ((y & 0x100) >> 4) | ((x & 0x3FF) >> 6);
+}
+
+static u16 Gfx_GetClut(s32 x, s32 y)
+{
+	return (y << 6) | ((x >> 4) & 0x3F);
+}
+
+//VRAM transfers
+static void Gfx_LoadImage(const RECT *rect, const u16 *data)
+{
+	for (s32 y = 0; y < rect->h; y++)
+		for (s32 x = 0; x < rect->w; x++)
+			vram[(rect->y + y) & (VRAM_HEIGHT - 1)][(rect->x + x) & (VRAM_WIDTH - 1)] = *data++;
+}
+
+static void Gfx_StoreImage(const RECT *rect, u16 *data)
+{
+	for (s32 y = 0; y < rect->h; y++)
+		for (s32 x = 0; x < rect->w; x++)
+			*data++ = vram[(rect->y + y) & (VRAM_HEIGHT - 1)][(rect->x + x) & (VRAM_WIDTH - 1)];
+}
+
+static void Gfx_ClearImage(const RECT *rect, u8 r, u8 g, u8 b)
+{
+	u16 col = (r >> 3) | ((g >> 3) << 5) | ((b >> 3) << 10);
+	for (s32 y = 0; y < rect->h; y++)
+		for (s32 x = 0; x < rect->w; x++)
+			vram[(rect->y + y) & (VRAM_HEIGHT - 1)][(rect->x + x) & (VRAM_WIDTH - 1)] = col;
+}
+
+static void Gfx_BackupRect(const RECT *rect)
+{
+	if (!gfx_backup_active)
+		return;
+
+	//Don't save the same area twice, the first copy is the one to restore
+	for (u8 i = 0; i < gfx_backups; i++)
+	{
+		const RECT *prev = &gfx_backup[i].rect;
+		if (rect->x >= prev->x && rect->y >= prev->y &&
+		    rect->x + rect->w <= prev->x + prev->w && rect->y + rect->h <= prev->y + prev->h)
+			return;
+	}
+
+	//Read area back from VRAM
+	u16 *data;
+	if (gfx_backups >= GFX_BACKUP_MAX || (data = Mem_Alloc(rect->w * rect->h * 2)) == NULL)
+	{
+		gfx_backup_lost = true;
+		return;
+	}
+	Gfx_StoreImage(rect, data);
+
+	gfx_backup[gfx_backups].rect = *rect;
+	gfx_backup[gfx_backups].data = data;
+	gfx_backups++;
+}
+
+//Pixel pipeline
+static u16 Gfx_Texel(u16 tpage, u16 clut, u8 u, u8 v)
+{
+	s32 tx = (tpage & 0xF) << 6;
+	s32 ty = (tpage & 0x10) << 4;
+	s32 cx = (clut & 0x3F) << 4;
+	s32 cy = (clut >> 6) & (VRAM_HEIGHT - 1);
+	u16 *row = vram[(ty + v) & (VRAM_HEIGHT - 1)];
+
+	switch ((tpage >> 7) & 0x3)
+	{
+		case 0: //4bpp
+		{
+			u16 word = row[(tx + (u >> 2)) & (VRAM_WIDTH - 1)];
+			return vram[cy][(cx + ((word >> ((u & 3) << 2)) & 0xF)) & (VRAM_WIDTH - 1)];
+		}
+		case 1: //8bpp
+		{
+			u16 word = row[(tx + (u >> 1)) & (VRAM_WIDTH - 1)];
+			return vram[cy][(cx + ((word >> ((u & 1) << 3)) & 0xFF)) & (VRAM_WIDTH - 1)];
+		}
+		default: //15bpp
+			return row[(tx + u) & (VRAM_WIDTH - 1)];
+	}
+}
+
+static u16 Gfx_Modulate(u16 col, u8 r, u8 g, u8 b)
+{
+	//0x80 leaves the texel as is
+	s32 cr = (( col        & 0x1F) * r) >> 7;
+	s32 cg = (((col >>  5) & 0x1F) * g) >> 7;
+	s32 cb = (((col >> 10) & 0x1F) * b) >> 7;
+	if (cr > 0x1F) cr = 0x1F;
+	if (cg > 0x1F) cg = 0x1F;
+	if (cb > 0x1F) cb = 0x1F;
+	return (col & 0x8000) | cr | (cg << 5) | (cb << 10);
+}
+
+static u16 Gfx_Blend(u16 back, u16 front, u8 abr)
+{
+	u16 out = front & 0x8000;
+	for (u8 i = 0; i < 15; i += 5)
+	{
+		s32 b = (back >> i) & 0x1F;
+		s32 f = (front >> i) & 0x1F;
+		s32 c;
+		switch (abr)
+		{
+			case 0: c = (b + f) >> 1; break;
+			case 1: c = b + f;        break;
+			case 2: c = b - f;        break;
+			default: c = b + (f >> 2); break;
+		}
+		if (c < 0)
+			c = 0;
+		if (c > 0x1F)
+			c = 0x1F;
+		out |= c << i;
+	}
+	return out;
+}
+
+static void Gfx_Plot(s32 x, s32 y, u16 col, boolean semi, u8 abr)
+{
+	u16 *dst = &vram[y][x];
+	*dst = semi ? Gfx_Blend(*dst, col, abr) : col;
+}
+
+static void Gfx_Fill(const Gfx_Prim *prim)
+{
+	//Count every covered pixel, the GPU spends the time even on skipped texels
+	u8 depth = GFX_FILL_FLAT, blend = 0;
+	if (prim->type != GfxPrim_F4 && prim->type != GfxPrim_G4)
+	{
+		depth = (gfx_tpage >> 7) & 0x3;
+		if (depth == GFX_FILL_FLAT)
+			depth = 2; //Mode 3 also reads 15bpp
+	}
+	if (prim->semi)
+		blend = 1 + ((gfx_tpage >> 5) & 0x3);
+	gfx_fill.pixels[depth][blend]++;
+	gfx_fill.layer[prim->fill_layer]++;
+}
+
+static void Gfx_Shade(const Gfx_Prim *prim, s32 x, s32 y, s32 u, s32 v, s32 r, s32 g, s32 b)
+{
+	gfx_pixels++;
+	Gfx_Fill(prim);
+
+	if (prim->type == GfxPrim_F4 || prim->type == GfxPrim_G4)
+	{
+		//Untextured, semi-transparency applies to every pixel
+		u16 col = (r >> 3) | ((g >> 3) << 5) | ((b >> 3) << 10);
+		Gfx_Plot(x, y, col, prim->semi, (gfx_tpage >> 5) & 0x3);
+	}
+	else
+	{
+		//Textured, black texels are skipped and only ones with the top bit set are blended
+		u16 texel = Gfx_Texel(gfx_tpage, prim->clut, u, v);
+		if (texel == 0)
+			return;
+		Gfx_Plot(x, y, Gfx_Modulate(texel, r, g, b), prim->semi && (texel & 0x8000), (gfx_tpage >> 5) & 0x3);
+	}
+}
+
+//Rasteriser
+typedef struct
+{
+	s32 x, y, u, v, r, g, b;
+} Gfx_Vert;
+
+static s64 Gfx_Edge(const Gfx_Vert *a, const Gfx_Vert *b, s32 x, s32 y)
+{
+	//Widened before multiplying, far off-screen vertices overflow s32
+	return (s64)(b->x - a->x) * (y - a->y) - (s64)(b->y - a->y) * (x - a->x);
+}
+
+static boolean Gfx_EdgeTopLeft(const Gfx_Vert *a, const Gfx_Vert *b)
+{
+	s32 dx = b->x - a->x, dy = b->y - a->y;
+	return (dy == 0 && dx > 0) || dy < 0;
+}
+
+static s32 Gfx_Lerp(s64 w0, s64 w1, s64 w2, s32 a0, s32 a1, s32 a2, s64 area)
+{
+	s64 num = w0 * a0 + w1 * a1 + w2 * a2;
+	return (s32)((num >= 0) ? (num / area) : -((-num + area - 1) / area));
+}
+
+static void Gfx_RasterTri(const Gfx_Prim *prim, const Gfx_Vert *v0, const Gfx_Vert *v1, const Gfx_Vert *v2)
+{
+	//Wind consistently
+	s64 area = Gfx_Edge(v0, v1, v2->x, v2->y);
+	if (area == 0)
+		return;
+	if (area < 0)
+	{
+		const Gfx_Vert *t = v1;
+		v1 = v2;
+		v2 = t;
+		area = -area;
+	}
+
+	//Get bounds within the drawing area, right and bottom edges aren't drawn
+	s32 x0 = v0->x, x1 = v0->x, y0 = v0->y, y1 = v0->y;
+	if (v1->x < x0) x0 = v1->x;
+	if (v2->x < x0) x0 = v2->x;
+	if (v1->x > x1) x1 = v1->x;
+	if (v2->x > x1) x1 = v2->x;
+	if (v1->y < y0) y0 = v1->y;
+	if (v2->y < y0) y0 = v2->y;
+	if (v1->y > y1) y1 = v1->y;
+	if (v2->y > y1) y1 = v2->y;
+
+	//The GPU drops polygons wider than 1023 or taller than 511 pixels
+	if (x1 - x0 > 1023 || y1 - y0 > 511)
+		return;
+
+	if (x0 < gfx_env.clip.x)
+		x0 = gfx_env.clip.x;
+	if (y0 < gfx_env.clip.y)
+		y0 = gfx_env.clip.y;
+	if (x1 > gfx_env.clip.x + gfx_env.clip.w)
+		x1 = gfx_env.clip.x + gfx_env.clip.w;
+	if (y1 > gfx_env.clip.y + gfx_env.clip.h)
+		y1 = gfx_env.clip.y + gfx_env.clip.h;
+
+	s32 bias0 = Gfx_EdgeTopLeft(v1, v2) ? 0 : 1;
+	s32 bias1 = Gfx_EdgeTopLeft(v2, v0) ? 0 : 1;
+	s32 bias2 = Gfx_EdgeTopLeft(v0, v1) ? 0 : 1;
+
+	for (s32 y = y0; y < y1; y++)
+	{
+		for (s32 x = x0; x < x1; x++)
+		{
+			s64 w0 = Gfx_Edge(v1, v2, x, y);
+			s64 w1 = Gfx_Edge(v2, v0, x, y);
+			s64 w2 = Gfx_Edge(v0, v1, x, y);
+			if (w0 < bias0 || w1 < bias1 || w2 < bias2)
+				continue;
+
+			Gfx_Shade(prim, x, y,
+				Gfx_Lerp(w0, w1, w2, v0->u, v1->u, v2->u, area) & 0xFF,
+				Gfx_Lerp(w0, w1, w2, v0->v, v1->v, v2->v, area) & 0xFF,
+				Gfx_Lerp(w0, w1, w2, v0->r, v1->r, v2->r, area),
+				Gfx_Lerp(w0, w1, w2, v0->g, v1->g, v2->g, area),
+				Gfx_Lerp(w0, w1, w2, v0->b, v1->b, v2->b, area)
+			);
+		}
+	}
+}
+
+static void Gfx_RasterQuad(const Gfx_Prim *prim)
+{
+	//Quads are drawn as triangles 0-1-2 and 1-2-3
+	Gfx_Vert vert[4];
+	for (u8 i = 0; i < 4; i++)
+	{
+		vert[i].x = prim->x[i] + gfx_env.ofs_x;
+		vert[i].y = prim->y[i] + gfx_env.ofs_y;
+		vert[i].u = prim->u[i];
+		vert[i].v = prim->v[i];
+		vert[i].r = prim->r[i];
+		vert[i].g = prim->g[i];
+		vert[i].b = prim->b[i];
+	}
+	Gfx_RasterTri(prim, &vert[0], &vert[1], &vert[2]);
+	Gfx_RasterTri(prim, &vert[1], &vert[2], &vert[3]);
+}
+
+static void Gfx_RasterSprt(const Gfx_Prim *prim)
+{
+	s32 x = prim->x[0] + gfx_env.ofs_x;
+	s32 y = prim->y[0] + gfx_env.ofs_y;
+	for (s32 j = 0; j < prim->h; j++)
+	{
+		s32 py = y + j;
+		if (py < gfx_env.clip.y || py >= gfx_env.clip.y + gfx_env.clip.h)
+			continue;
+		for (s32 i = 0; i < prim->w; i++)
+		{
+			s32 px = x + i;
+			if (px < gfx_env.clip.x || px >= gfx_env.clip.x + gfx_env.clip.w)
+				continue;
+			Gfx_Shade(prim, px, py, (prim->u[0] + i) & 0xFF, (prim->v[0] + j) & 0xFF, prim->r[0], prim->g[0], prim->b[0]);
+		}
+	}
+}
+
+static void Gfx_ApplyEnv(const Gfx_Env *env)
+{
+	gfx_env = *env;
+	if (gfx_env.clip.x < 0)
+		gfx_env.clip.x = 0;
+	if (gfx_env.clip.y < 0)
+		gfx_env.clip.y = 0;
+	if (gfx_env.clip.x + gfx_env.clip.w > VRAM_WIDTH)
+		gfx_env.clip.w = VRAM_WIDTH - gfx_env.clip.x;
+	if (gfx_env.clip.y + gfx_env.clip.h > VRAM_HEIGHT)
+		gfx_env.clip.h = VRAM_HEIGHT - gfx_env.clip.y;
+	if (gfx_env.isbg)
+		Gfx_ClearImage(&gfx_env.clip, gfx_env.r, gfx_env.g, gfx_env.b);
+}
+
+static void Gfx_Execute(void)
+{
+	//Last submitted is drawn first
+	for (u16 i = gfx_prims; i-- > 0;)
+	{
+		const Gfx_Prim *prim = &gfx_prim[i];
+		switch (prim->type)
+		{
+			case GfxPrim_F4:
+			case GfxPrim_G4:
+				Gfx_RasterQuad(prim);
+				break;
+			case GfxPrim_FT4:
+				gfx_tpage = prim->tpage;
+				Gfx_RasterQuad(prim);
+				break;
+			case GfxPrim_Sprt:
+				Gfx_RasterSprt(prim);
+				break;
+			case GfxPrim_TPage:
+				gfx_tpage = prim->tpage;
+				break;
+		}
+	}
+}
+
+static Gfx_Prim *Gfx_AddPrim(Gfx_PrimType type)
+{
+	//Running out drops the primitive, the PSX would have overrun its buffer
+	if (gfx_prims >= GFX_PRIMS)
+	{
+		static Gfx_Prim dummy;
+		return &dummy;
+	}
+	Gfx_Prim *prim = &gfx_prim[gfx_prims++];
+	memset(prim, 0, sizeof(*prim));
+	prim->type = type;
+	prim->fill_layer = gfx_fill_layer;
+	return prim;
+}
+
+static void Gfx_SetXYWH(Gfx_Prim *prim, s32 x, s32 y, s32 w, s32 h)
+{
+	prim->x[0] = x;     prim->y[0] = y;
+	prim->x[1] = x + w; prim->y[1] = y;
+	prim->x[2] = x;     prim->y[2] = y + h;
+	prim->x[3] = x + w; prim->y[3] = y + h;
+}
+
+static void Gfx_SetUVWH(Gfx_Prim *prim, s32 u, s32 v, s32 w, s32 h)
+{
+	prim->u[0] = u;     prim->v[0] = v;
+	prim->u[1] = u + w; prim->v[1] = v;
+	prim->u[2] = u;     prim->v[2] = v + h;
+	prim->u[3] = u + w; prim->v[3] = v + h;
+}
+
+static void Gfx_SetRGB(Gfx_Prim *prim, u8 i, u8 r, u8 g, u8 b)
+{
+	prim->r[i] = r;
+	prim->g[i] = g;
+	prim->b[i] = b;
+}
+
+static void Gfx_SetFlatRGB(Gfx_Prim *prim, u8 r, u8 g, u8 b)
+{
+	for (u8 i = 0; i < 4; i++)
+		Gfx_SetRGB(prim, i, r, g, b);
+}
+
+static void Gfx_AddTPage(u16 tpage)
+{
+	Gfx_AddPrim(GfxPrim_TPage)->tpage = tpage;
+}
+
+//PNG writer, stored deflate blocks keep it tiny and exact
+static u32 Gfx_PNGCrc(u32 crc, const u8 *data, size_t len)
+{
+	crc = ~crc;
+	while (len-- > 0)
+	{
+		crc ^= *data++;
+		for (u8 i = 0; i < 8; i++)
+			crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+	}
+	return ~crc;
+}
+
+static void Gfx_PNGPut32(u8 *out, u32 x)
+{
+	out[0] = x >> 24;
+	out[1] = x >> 16;
+	out[2] = x >> 8;
+	out[3] = x;
+}
+
+static void Gfx_PNGChunk(FILE *fp, const char *type, const u8 *data, u32 len)
+{
+	u8 head[8];
+	Gfx_PNGPut32(head, len);
+	memcpy(head + 4, type, 4);
+	u32 crc = Gfx_PNGCrc(Gfx_PNGCrc(0, head + 4, 4), data, len);
+
+	u8 tail[4];
+	Gfx_PNGPut32(tail, crc);
+	fwrite(head, 1, 8, fp);
+	fwrite(data, 1, len, fp);
+	fwrite(tail, 1, 4, fp);
+}
+
+static boolean Gfx_WritePNG(const char *path, const RECT *rect)
+{
+	//Convert to rows of filter byte + RGB
+	u32 stride = 1 + rect->w * 3;
+	u32 raw_len = stride * rect->h;
+	u8 *raw = malloc(raw_len);
+	if (raw == NULL)
+		return false;
+
+	u8 *p = raw;
+	for (s32 y = 0; y < rect->h; y++)
+	{
+		*p++ = 0;
+		const u16 *row = vram[(rect->y + y) & (VRAM_HEIGHT - 1)];
+		for (s32 x = 0; x < rect->w; x++)
+		{
+			u16 col = row[(rect->x + x) & (VRAM_WIDTH - 1)];
+			for (u8 i = 0; i < 15; i += 5)
+			{
+				u8 c = (col >> i) & 0x1F;
+				*p++ = (c << 3) | (c >> 2);
+			}
+		}
+	}
+
+	//Wrap in zlib stored blocks
+	u32 blocks = (raw_len + 0xFFFE) / 0xFFFF;
+	u32 zlen = 2 + blocks * 5 + raw_len + 4;
+	u8 *z = malloc(zlen);
+	if (z == NULL)
+	{
+		free(raw);
+		return false;
+	}
+
+	u8 *zp = z;
+	*zp++ = 0x78;
+	*zp++ = 0x01;
+	u32 s1 = 1, s2 = 0;
+	for (u32 pos = 0; pos < raw_len;)
+	{
+		u32 len = raw_len - pos;
+		if (len > 0xFFFF)
+			len = 0xFFFF;
+		*zp++ = (pos + len == raw_len);
+		*zp++ = len;
+		*zp++ = len >> 8;
+		*zp++ = ~len;
+		*zp++ = (~len) >> 8;
+		memcpy(zp, raw + pos, len);
+		zp += len;
+
+		for (u32 i = 0; i < len; i++)
+		{
+			s1 = (s1 + raw[pos + i]) % 65521;
+			s2 = (s2 + s1) % 65521;
+		}
+		pos += len;
+	}
+	Gfx_PNGPut32(zp, (s2 << 16) | s1);
+
+	//Write file
+	FILE *fp = fopen(path, "wb");
+	if (fp != NULL)
+	{
+		static const u8 sig[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+		u8 ihdr[13];
+		Gfx_PNGPut32(ihdr + 0, rect->w);
+		Gfx_PNGPut32(ihdr + 4, rect->h);
+		ihdr[8] = 8;  //Bit depth
+		ihdr[9] = 2;  //RGB
+		ihdr[10] = 0; //Deflate
+		ihdr[11] = 0; //Adaptive filtering
+		ihdr[12] = 0; //No interlace
+
+		fwrite(sig, 1, 8, fp);
+		Gfx_PNGChunk(fp, "IHDR", ihdr, 13);
+		Gfx_PNGChunk(fp, "IDAT", z, zlen);
+		Gfx_PNGChunk(fp, "IEND", NULL, 0);
+		fclose(fp);
+	}
+
+	free(z);
+	free(raw);
+	return fp != NULL;
+}
+
+//Gfx functions
+void Gfx_Init(void)
+{
+	//Clear VRAM
+	memset(vram, 0, sizeof(vram));
+
+	//Initialize draw environment, same layout as the PSX so VRAM use matches
+	static const RECT draw_area[2] = {
+		{0, 240, 320, 240},
+		{0,   0, 320, 240},
+	};
+	for (u8 i = 0; i < 2; i++)
+	{
+		draw[i].clip = draw_area[i];
+		draw[i].ofs_x = draw_area[i].x;
+		draw[i].ofs_y = draw_area[i].y;
+		draw[i].isbg = 1;
+		draw[i].r = draw[i].g = draw[i].b = 0;
+	}
+
+	//Initialize drawing state
+	gfx_prims = 0;
+	gfx_pixels = gfx_pixels_last = 0;
+	gfx_frame = 0;
+	gfx_tpage = 0;
+	db = 0;
+	gfx_display = draw[1].clip;
+}
+
+void Gfx_Quit(void)
+{
+
+}
+
+void Gfx_Flip(void)
+{
+	//Draw frame
+	Profiler_Begin(ProfScope_Flip);
+	Gfx_ApplyEnv(&draw[db]);
+	Gfx_Execute();
+	Profiler_End(ProfScope_Flip);
+
+	gfx_display = draw[db].clip;
+	gfx_pixels_last = gfx_pixels;
+	gfx_pixels = 0;
+	gfx_fill_last = gfx_fill;
+	memset(&gfx_fill, 0, sizeof(gfx_fill));
+	gfx_fill_layer = 0;
+
+	//Dump every frame if asked to
+	const char *dump = getenv("PSXF_GFX_DUMP");
+	if (dump != NULL)
+	{
+		char path[256];
+		sprintf(path, "%.200s/frame-%05lu.png", dump, (unsigned long)gfx_frame);
+		Gfx_WriteFrame(path);
+	}
+	gfx_frame++;
+
+	//Flip buffers
+	db ^= 1;
+	gfx_prims = 0;
+}
+
+void Gfx_SetClear(u8 r, u8 g, u8 b)
+{
+	draw[0].r = draw[1].r = r;
+	draw[0].g = draw[1].g = g;
+	draw[0].b = draw[1].b = b;
+}
+
+void Gfx_EnableClear(void)
+{
+	draw[0].isbg = draw[1].isbg = 1;
+}
+
+void Gfx_DisableClear(void)
+{
+	draw[0].isbg = draw[1].isbg = 0;
+}
+
+void Gfx_LoadTex(Gfx_Tex *tex, IO_Data data, Gfx_LoadTex_Flag flag)
+{
+	//Catch NULL data
+	if (data == NULL)
+	{
+		sprintf(error_msg, "[Gfx_LoadTex] data is NULL");
+		ErrorLock();
+	}
+
+	//Read TIM information
+	const u32 *tim = (const u32*)data;
+	u32 mode = tim[1];
+	tim += 2;
+
+	RECT crect, prect;
+	const u16 *caddr = NULL, *paddr;
+	if (mode & 0x8)
+	{
+		const u16 *block = (const u16*)(tim + 1);
+		crect.x = block[0]; crect.y = block[1]; crect.w = block[2]; crect.h = block[3];
+		caddr = block + 4;
+		tim += tim[0] >> 2;
+	}
+	const u16 *block = (const u16*)(tim + 1);
+	prect.x = block[0]; prect.y = block[1]; prect.w = block[2]; prect.h = block[3];
+	paddr = block + 4;
+
+	if (tex != NULL)
+	{
+		tex->tim_mode = mode;
+		tex->pxshift = (2 - (mode & 0x3));
+	}
+
+	//Upload pixel data to framebuffer
+	if (!(flag & GFX_LOADTEX_NOTEX))
+	{
+		if (tex != NULL)
+		{
+			tex->tim_prect = prect;
+			tex->tpage = Gfx_GetTPage(mode, 0, prect.x, prect.y);
+		}
+		Gfx_BackupRect(&prect);
+		Profiler_Event(ProfEvent_Upload, "Texture", prect.w * prect.h * 2);
+		Gfx_LoadImage(&prect, paddr);
+	}
+
+	//Upload CLUT to framebuffer if present
+	if ((mode & 0x8) && !(flag & GFX_LOADTEX_NOCLUT))
+	{
+		if (tex != NULL)
+		{
+			tex->tim_crect = crect;
+			tex->clut = Gfx_GetClut(crect.x, crect.y);
+		}
+		Gfx_BackupRect(&crect);
+		Profiler_Event(ProfEvent_Upload, "CLUT", crect.w * crect.h * 2);
+		Gfx_LoadImage(&crect, caddr);
+	}
+
+	//Free data
+	if (flag & GFX_LOADTEX_FREE)
+		Mem_Free(data);
+}
+
+void Gfx_DrawRect(const RECT *rect, u8 r, u8 g, u8 b)
+{
+	//Add quad
+	Gfx_Prim *quad = Gfx_AddPrim(GfxPrim_F4);
+	Gfx_SetXYWH(quad, rect->x, rect->y, rect->w, rect->h);
+	Gfx_SetFlatRGB(quad, r, g, b);
+}
+
+void Gfx_BlendRect(const RECT *rect, u8 r, u8 g, u8 b, u8 mode)
+{
+	//Add quad
+	Gfx_Prim *quad = Gfx_AddPrim(GfxPrim_F4);
+	Gfx_SetXYWH(quad, rect->x, rect->y, rect->w, rect->h);
+	Gfx_SetFlatRGB(quad, r, g, b);
+	quad->semi = true;
+
+	//Add tpage change (this controls transparency mode)
+	Gfx_AddTPage(Gfx_GetTPage(0, mode, 0, 0));
+}
+
+void Gfx_DrawGradientRect(const RECT *rect, u8 r0, u8 g0, u8 b0, u8 r1, u8 g1, u8 b1)
+{
+	//Add gouraud quad, top edge coloured by rgb0 and bottom edge by rgb1
+	Gfx_Prim *quad = Gfx_AddPrim(GfxPrim_G4);
+	Gfx_SetXYWH(quad, rect->x, rect->y, rect->w, rect->h);
+	Gfx_SetRGB(quad, 0, r0, g0, b0);
+	Gfx_SetRGB(quad, 1, r0, g0, b0);
+	Gfx_SetRGB(quad, 2, r1, g1, b1);
+	Gfx_SetRGB(quad, 3, r1, g1, b1);
+}
+
+void Gfx_BlendGradientRect(const RECT *rect, u8 r0, u8 g0, u8 b0, u8 r1, u8 g1, u8 b1, u8 mode)
+{
+	//Add gouraud quad
+	Gfx_Prim *quad = Gfx_AddPrim(GfxPrim_G4);
+	Gfx_SetXYWH(quad, rect->x, rect->y, rect->w, rect->h);
+	Gfx_SetRGB(quad, 0, r0, g0, b0);
+	Gfx_SetRGB(quad, 1, r0, g0, b0);
+	Gfx_SetRGB(quad, 2, r1, g1, b1);
+	Gfx_SetRGB(quad, 3, r1, g1, b1);
+	quad->semi = true;
+
+	//Add tpage change (this controls transparency mode)
+	Gfx_AddTPage(Gfx_GetTPage(0, mode, 0, 0));
+}
+
+void Gfx_BlitTexCol(Gfx_Tex *tex, const RECT *src, s32 x, s32 y, u8 r, u8 g, u8 b)
+{
+	//Add sprite
+	Gfx_Prim *sprt = Gfx_AddPrim(GfxPrim_Sprt);
+	sprt->x[0] = x;
+	sprt->y[0] = y;
+	sprt->w = src->w;
+	sprt->h = src->h;
+	sprt->u[0] = src->x;
+	sprt->v[0] = src->y;
+	Gfx_SetRGB(sprt, 0, r, g, b);
+	sprt->clut = tex->clut;
+
+	//Add tpage change
+	Gfx_AddTPage(tex->tpage);
+}
+
+void Gfx_BlitTex(Gfx_Tex *tex, const RECT *src, s32 x, s32 y)
+{
+	Gfx_BlitTexCol(tex, src, x, y, 0x80, 0x80, 0x80);
+}
+
+void Gfx_DrawTexCol(Gfx_Tex *tex, const RECT *src, const RECT *dst, u8 r, u8 g, u8 b)
+{
+	//Manipulate rects to comply with GPU restrictions
+	RECT csrc, cdst;
+	csrc = *src;
+	cdst = *dst;
+
+	if (dst->w < 0)
+		csrc.x--;
+	if (dst->h < 0)
+		csrc.y--;
+
+	if ((csrc.x + csrc.w) >= 0x100)
+	{
+		csrc.w = 0xFF - csrc.x;
+		cdst.w = cdst.w * csrc.w / src->w;
+	}
+	if ((csrc.y + csrc.h) >= 0x100)
+	{
+		csrc.h = 0xFF - csrc.y;
+		cdst.h = cdst.h * csrc.h / src->h;
+	}
+
+	//Add quad
+	Gfx_Prim *quad = Gfx_AddPrim(GfxPrim_FT4);
+	Gfx_SetUVWH(quad, src->x, src->y, csrc.w, csrc.h);
+	Gfx_SetXYWH(quad, cdst.x, cdst.y, cdst.w, cdst.h);
+	Gfx_SetFlatRGB(quad, r, g, b);
+	quad->tpage = tex->tpage;
+	quad->clut = tex->clut;
+}
+
+void Gfx_BlendTex(Gfx_Tex *tex, const RECT *src, const RECT *dst, u8 mode)
+{
+	//Manipulate rects to comply with GPU restrictions
+	RECT csrc, cdst;
+	csrc = *src;
+	cdst = *dst;
+
+	if (dst->w < 0)
+		csrc.x--;
+	if (dst->h < 0)
+		csrc.y--;
+
+	if ((csrc.x + csrc.w) >= 0x100)
+	{
+		csrc.w = 0xFF - csrc.x;
+		cdst.w = cdst.w * csrc.w / src->w;
+	}
+	if ((csrc.y + csrc.h) >= 0x100)
+	{
+		csrc.h = 0xFF - csrc.y;
+		cdst.h = cdst.h * csrc.h / src->h;
+	}
+
+	//Add quad, like setSemiTrans the mode only switches blending on and the tpage picks how
+	Gfx_Prim *quad = Gfx_AddPrim(GfxPrim_FT4);
+	Gfx_SetUVWH(quad, src->x, src->y, csrc.w, csrc.h);
+	Gfx_SetXYWH(quad, cdst.x, cdst.y, cdst.w, cdst.h);
+	Gfx_SetFlatRGB(quad, 0x80, 0x80, 0x80);
+	quad->semi = mode != 0;
+	quad->tpage = tex->tpage;
+	quad->clut = tex->clut;
+}
+
+void Gfx_DrawTex(Gfx_Tex *tex, const RECT *src, const RECT *dst)
+{
+	Gfx_DrawTexCol(tex, src, dst, 0x80, 0x80, 0x80);
+}
+
+void Gfx_DrawTexArbCol(Gfx_Tex *tex, const RECT *src, const POINT *p0, const POINT *p1, const POINT *p2, const POINT *p3, u8 r, u8 g, u8 b)
+{
+	//Add quad
+	Gfx_Prim *quad = Gfx_AddPrim(GfxPrim_FT4);
+	Gfx_SetUVWH(quad, src->x, src->y, src->w, src->h);
+	quad->x[0] = p0->x; quad->y[0] = p0->y;
+	quad->x[1] = p1->x; quad->y[1] = p1->y;
+	quad->x[2] = p2->x; quad->y[2] = p2->y;
+	quad->x[3] = p3->x; quad->y[3] = p3->y;
+	Gfx_SetFlatRGB(quad, r, g, b);
+	quad->tpage = tex->tpage;
+	quad->clut = tex->clut;
+}
+
+void Gfx_DrawTexArb(Gfx_Tex *tex, const RECT *src, const POINT *p0, const POINT *p1, const POINT *p2, const POINT *p3)
+{
+	Gfx_DrawTexArbCol(tex, src, p0, p1, p2, p3, 0x80, 0x80, 0x80);
+}
+
+void Gfx_BlendTexArbCol(Gfx_Tex *tex, const RECT *src, const POINT *p0, const POINT *p1, const POINT *p2, const POINT *p3, u8 r, u8 g, u8 b, u8 mode)
+{
+	//Add quad, the PSX version doesn't set the semi-transparency flag either
+	Gfx_Prim *quad = Gfx_AddPrim(GfxPrim_FT4);
+	Gfx_SetUVWH(quad, src->x, src->y, src->w, src->h);
+	quad->x[0] = p0->x; quad->y[0] = p0->y;
+	quad->x[1] = p1->x; quad->y[1] = p1->y;
+	quad->x[2] = p2->x; quad->y[2] = p2->y;
+	quad->x[3] = p3->x; quad->y[3] = p3->y;
+	Gfx_SetFlatRGB(quad, r, g, b);
+	quad->tpage = tex->tpage | Gfx_GetTPage(0, mode, 0, 0);
+	quad->clut = tex->clut;
+}
+
+void Gfx_BlendTexArb(Gfx_Tex *tex, const RECT *src, const POINT *p0, const POINT *p1, const POINT *p2, const POINT *p3, u8 mode)
+{
+	Gfx_BlendTexArbCol(tex, src, p0, p1, p2, p3, 0x80, 0x80, 0x80, mode);
+}
+
+void Gfx_SetFillLayer(u8 layer)
+{
+	//Layers past the end are counted with the first
+	gfx_fill_layer = (layer < GFX_FILL_LAYERS) ? layer : 0;
+}
+
+void Gfx_GetFillStats(Gfx_FillStats *stats)
+{
+	*stats = gfx_fill_last;
+}
+
+void Gfx_BackupBegin(void)
+{
+	Gfx_BackupEnd();
+	gfx_backup_active = true;
+	gfx_backup_lost = false;
+	gfx_backup_clear[0] = draw[0].r;
+	gfx_backup_clear[1] = draw[0].g;
+	gfx_backup_clear[2] = draw[0].b;
+}
+
+boolean Gfx_BackupRestore(void)
+{
+	if (!gfx_backup_active)
+		return false;
+
+	//Restore newest first so overlapping areas end up with their oldest contents
+	for (u8 i = gfx_backups; i-- > 0;)
+	{
+		Profiler_Event(ProfEvent_Upload, "Backup", gfx_backup[i].rect.w * gfx_backup[i].rect.h * 2);
+		Gfx_LoadImage(&gfx_backup[i].rect, gfx_backup[i].data);
+	}
+	Gfx_SetClear(gfx_backup_clear[0], gfx_backup_clear[1], gfx_backup_clear[2]);
+
+	boolean complete = !gfx_backup_lost;
+	Gfx_BackupEnd();
+	return complete;
+}
+
+void Gfx_BackupEnd(void)
+{
+	//Free saved areas
+	while (gfx_backups > 0)
+		Mem_Free(gfx_backup[--gfx_backups].data);
+	gfx_backup_active = false;
+}
+
+boolean Gfx_WriteFrame(const char *path)
+{
+	return Gfx_WritePNG(path, &gfx_display);
+}
+
+u32 Gfx_GetPixels(void)
+{
+	return gfx_pixels_last;
+}
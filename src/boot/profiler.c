@@ -0,0 +1,353 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "profiler.h"
+
+#ifdef PSXF_PROFILE
+
+#ifdef PSXF_TRACE
+	#include <stdarg.h>
+#endif
+
+//Profiler constants
+#ifdef PSXF_PC
+	#define PROFILER_PERSEC 1000000 //Microseconds, which is also what traces use
+#else
+	#define PROFILER_PERSEC (33868800 / 8) //Root counter 2 runs at the system clock / 8
+#endif
+#define PROFILER_FRAME  (PROFILER_PERSEC / 60)
+#define PROFILER_AVG_SHIFT 3 //Averages over about 8 frames
+#define PROFILER_WINDOW 60 //Frames between maximum resets
+#define PROFILER_BAR 10 //Characters for one 60Hz frame
+
+//Profiler state
+typedef struct
+{
+	u32 start, acc;
+	u32 avg_sum, max, max_last;
+} Profiler_Scope;
+
+static Profiler_Scope profiler_scope[ProfScope_Max + 1]; //Last one is the whole frame
+static u32 profiler_frame_start;
+static u8 profiler_window;
+static boolean profiler_show;
+
+static const char *profiler_name[ProfScope_Max + 1] = {
+	"PAD ",
+	"TICK",
+	"LOGC",
+	"HUD ",
+	"NOTE",
+	"OBJ ",
+	"CHAR",
+	"BG  ",
+	"IO  ",
+	"FLIP",
+	"FRM ",
+};
+
+#ifdef PSXF_TRACE
+	static FILE *profiler_trace;
+	static boolean profiler_trace_first;
+	static u32 profiler_trace_frame, profiler_trace_allocs;
+
+	static const char *profiler_trace_name[ProfScope_Max + 1] = {
+		"Pad_Update",
+		"Tick",
+		"Stage logic",
+		"Stage HUD",
+		"Stage notes",
+		"ObjectList_Tick",
+		"Characters",
+		"Stage overlay",
+		"IO",
+		"Gfx_Flip wait",
+		"Frame",
+	};
+
+	static const char *profiler_event_name[] = {
+		"Upload",
+	};
+#endif
+
+//Counter
+#ifdef PSXF_PC
+
+static time_t profiler_epoch;
+
+static u32 Profiler_Count(void)
+{
+	//Count from when the profiler started, so traces don't wrap for over an hour
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u32)(ts.tv_sec - profiler_epoch) * 1000000 + (u32)(ts.tv_nsec / 1000);
+}
+
+#else
+
+static volatile u32 profiler_wraps;
+
+extern void InterruptCallback(int index, void (*cb)(void));
+extern void ChangeClearRCnt(int t, int m);
+
+static void Profiler_Callback(void)
+{
+	profiler_wraps++;
+}
+
+static u32 Profiler_Count(void)
+{
+	//Read until the wrap count didn't change underneath us
+	u32 wraps, count;
+	do
+	{
+		wraps = profiler_wraps;
+		count = GetRCnt(RCntCNT2) & 0xFFFF;
+	} while (wraps != profiler_wraps);
+	return (wraps << 16) | count;
+}
+
+#endif
+
+static u32 Profiler_Since(u32 start)
+{
+	//A wrap that hasn't been serviced yet can make time go backwards
+	u32 delta = Profiler_Count() - start;
+	if (delta & 0x80000000)
+		return 0;
+	return delta;
+}
+
+//Trace writer
+#ifdef PSXF_TRACE
+
+static void Profiler_TraceOpen(void)
+{
+	//Write each run to its own file unless told where to
+	char path[64];
+	const char *env = getenv("PSXF_TRACE_FILE");
+	if (env == NULL)
+	{
+		sprintf(path, "funkin-%lu.json", (unsigned long)time(NULL));
+		env = path;
+	}
+
+	if ((profiler_trace = fopen(env, "w")) == NULL)
+		return;
+	fputs("{\"traceEvents\":[\n", profiler_trace);
+	profiler_trace_first = true;
+	profiler_trace_frame = profiler_trace_allocs = 0;
+}
+
+static void Profiler_TraceClose(void)
+{
+	if (profiler_trace == NULL)
+		return;
+	fputs("\n],\"displayTimeUnit\":\"ms\"}\n", profiler_trace);
+	fclose(profiler_trace);
+	profiler_trace = NULL;
+}
+
+static void Profiler_TraceWrite(const char *format, ...)
+{
+	//Events are written as they happen, the viewer sorts them
+	if (!profiler_trace_first)
+		fputs(",\n", profiler_trace);
+	profiler_trace_first = false;
+
+	va_list args;
+	va_start(args, format);
+	vfprintf(profiler_trace, format, args);
+	va_end(args);
+}
+
+static void Profiler_TraceString(char *buf, const char *str)
+{
+	//Escape for JSON, file paths are full of backslashes
+	char *end = buf + 60;
+	for (; *str != '\0' && buf < end; str++)
+	{
+		if (*str == '\\' || *str == '"')
+			*buf++ = '\\';
+		*buf++ = *str;
+	}
+	*buf = '\0';
+}
+
+static void Profiler_TraceScope(u8 scope, u32 start, u32 dur)
+{
+	if (profiler_trace == NULL)
+		return;
+	Profiler_TraceWrite("{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%lu,\"dur\":%lu,\"pid\":1,\"tid\":1}",
+		profiler_trace_name[scope], (unsigned long)start, (unsigned long)dur);
+}
+
+void Profiler_Event(ProfEvent event, const char *name, u32 size)
+{
+	if (profiler_trace == NULL)
+		return;
+	char esc[64];
+	Profiler_TraceString(esc, (name != NULL) ? name : "");
+	Profiler_TraceWrite("{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%lu,\"pid\":1,\"tid\":1,\"args\":{\"size\":%lu}}",
+		esc, profiler_event_name[event], (unsigned long)Profiler_Count(), (unsigned long)size);
+}
+
+void *Profiler_TraceAlloc(size_t size)
+{
+	void *ptr = malloc(size);
+	if (profiler_trace == NULL || ptr == NULL)
+		return ptr;
+
+	//Log the allocation and how many are live
+	u32 now = Profiler_Count();
+	Profiler_TraceWrite("{\"name\":\"Alloc\",\"cat\":\"Mem\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%lu,\"pid\":1,\"tid\":1,\"args\":{\"size\":%lu,\"ptr\":\"%p\"}}",
+		(unsigned long)now, (unsigned long)size, ptr);
+	Profiler_TraceWrite("{\"name\":\"Allocations\",\"ph\":\"C\",\"ts\":%lu,\"pid\":1,\"args\":{\"live\":%lu}}",
+		(unsigned long)now, (unsigned long)++profiler_trace_allocs);
+	return ptr;
+}
+
+void Profiler_TraceFree(void *ptr)
+{
+	if (profiler_trace != NULL && ptr != NULL)
+	{
+		u32 now = Profiler_Count();
+		Profiler_TraceWrite("{\"name\":\"Free\",\"cat\":\"Mem\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%lu,\"pid\":1,\"tid\":1,\"args\":{\"ptr\":\"%p\"}}",
+			(unsigned long)now, ptr);
+		Profiler_TraceWrite("{\"name\":\"Allocations\",\"ph\":\"C\",\"ts\":%lu,\"pid\":1,\"args\":{\"live\":%lu}}",
+			(unsigned long)now, (unsigned long)--profiler_trace_allocs);
+	}
+	free(ptr);
+}
+
+#endif
+
+//Profiler functions
+void Profiler_Init(void)
+{
+	//Clear state
+	memset(profiler_scope, 0, sizeof(profiler_scope));
+	profiler_window = 0;
+	profiler_show = false;
+
+	#ifdef PSXF_PC
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		profiler_epoch = ts.tv_sec;
+		
+		#ifdef PSXF_TRACE
+			Profiler_TraceOpen();
+		#endif
+	#else
+		//Setup counter IRQ
+		profiler_wraps = 0;
+
+		EnterCriticalSection();
+
+		SetRCnt(RCntCNT2, 0xFFFF, RCntMdINTR);
+		InterruptCallback(6, Profiler_Callback); //IRQ6 is RCNT2
+		StartRCnt(RCntCNT2);
+		ChangeClearRCnt(2, 0);
+
+		ExitCriticalSection();
+	#endif
+
+	profiler_frame_start = Profiler_Count();
+}
+
+void Profiler_Quit(void)
+{
+	#ifdef PSXF_PC
+		#ifdef PSXF_TRACE
+			Profiler_TraceClose();
+		#endif
+	#else
+		EnterCriticalSection();
+		StopRCnt(RCntCNT2);
+		InterruptCallback(6, NULL);
+		ExitCriticalSection();
+	#endif
+}
+
+void Profiler_Begin(ProfScope scope)
+{
+	profiler_scope[scope].start = Profiler_Count();
+}
+
+void Profiler_End(ProfScope scope)
+{
+	u32 dur = Profiler_Since(profiler_scope[scope].start);
+	profiler_scope[scope].acc += dur;
+	#ifdef PSXF_TRACE
+		Profiler_TraceScope(scope, profiler_scope[scope].start, dur);
+	#endif
+}
+
+void Profiler_Toggle(void)
+{
+	profiler_show = !profiler_show;
+}
+
+static void Profiler_Draw(void)
+{
+	for (u8 i = 0; i <= ProfScope_Max; i++)
+	{
+		Profiler_Scope *this = &profiler_scope[i];
+		u32 avg = this->avg_sum >> PROFILER_AVG_SHIFT;
+		u32 max = (this->max_last > this->max) ? this->max_last : this->max;
+
+		//Draw bar, # for the average and + up to the maximum
+		char bar[PROFILER_BAR + 1];
+		u32 avg_len = avg * PROFILER_BAR / PROFILER_FRAME;
+		u32 max_len = max * PROFILER_BAR / PROFILER_FRAME;
+		for (u8 j = 0; j < PROFILER_BAR; j++)
+			bar[j] = (j < avg_len) ? '#' : ((j < max_len) ? '+' : '.');
+		bar[PROFILER_BAR] = '\0';
+
+		//Draw times in tenths of a millisecond
+		u32 avg_ms = avg / (PROFILER_PERSEC / 10000);
+		u32 max_ms = max / (PROFILER_PERSEC / 10000);
+		FntPrint("%s %s %d.%d/%d.%d\n", profiler_name[i], bar, avg_ms / 10, avg_ms % 10, max_ms / 10, max_ms % 10);
+	}
+}
+
+void Profiler_Frame(void)
+{
+	//Time the whole frame
+	u32 now = Profiler_Count();
+	profiler_scope[ProfScope_Max].acc = now - profiler_frame_start;
+	#ifdef PSXF_TRACE
+		if (profiler_trace != NULL)
+			Profiler_TraceWrite("{\"name\":\"Frame\",\"ph\":\"X\",\"ts\":%lu,\"dur\":%lu,\"pid\":1,\"tid\":0,\"args\":{\"frame\":%lu}}",
+				(unsigned long)profiler_frame_start, (unsigned long)(now - profiler_frame_start), (unsigned long)profiler_trace_frame++);
+	#endif
+	profiler_frame_start = now;
+
+	//Roll this frame into the averages and maxima
+	boolean window_end = ++profiler_window >= PROFILER_WINDOW;
+	if (window_end)
+		profiler_window = 0;
+
+	for (u8 i = 0; i <= ProfScope_Max; i++)
+	{
+		Profiler_Scope *this = &profiler_scope[i];
+		this->avg_sum += this->acc - (this->avg_sum >> PROFILER_AVG_SHIFT);
+		if (this->acc > this->max)
+			this->max = this->acc;
+		if (window_end)
+		{
+			this->max_last = this->max;
+			this->max = 0;
+		}
+		this->acc = 0;
+	}
+
+	//Draw overlay
+	if (profiler_show)
+		Profiler_Draw();
+}
+
+#endif
@@ -0,0 +1,71 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#ifndef PSXF_GUARD_PROFILER_H
+#define PSXF_GUARD_PROFILER_H
+
+#include "psx.h"
+
+//Profiler scopes
+typedef enum
+{
+	ProfScope_Pad,     //Pad_Update
+	ProfScope_Tick,    //Menu, stage or movie tick
+	ProfScope_Logic,   //Stage song position and note processing
+	ProfScope_HUD,     //Stage score, health and botplay
+	ProfScope_Notes,   //Stage notes, splashes and strums
+	ProfScope_Objects, //ObjectList_Tick
+	ProfScope_Chars,   //Character ticks
+	ProfScope_BG,      //Stage overlay draws
+	ProfScope_IO,      //Blocking CD reads
+	ProfScope_Flip,    //Gfx_Flip waiting on the GPU and vsync
+	ProfScope_Max,
+} ProfScope;
+
+//Trace events, only host backends report them since tracing is host only
+typedef enum
+{
+	ProfEvent_Upload, //VRAM upload, size in bytes
+} ProfEvent;
+
+//Tracing needs a host to write the file to
+#ifndef PSXF_PC
+	#undef PSXF_TRACE
+#endif
+
+//Profiler interface, only debug and trace builds have one
+#if defined(PSXF_DEBUG) || defined(PSXF_TRACE)
+	#define PSXF_PROFILE
+#endif
+
+#ifdef PSXF_PROFILE
+	void Profiler_Init(void);
+	void Profiler_Quit(void);
+	void Profiler_Frame(void);
+	void Profiler_Toggle(void);
+
+	void Profiler_Begin(ProfScope scope);
+	void Profiler_End(ProfScope scope);
+#else
+	#define Profiler_Init()
+	#define Profiler_Quit()
+	#define Profiler_Frame()
+	#define Profiler_Toggle()
+
+	#define Profiler_Begin(scope)
+	#define Profiler_End(scope)
+#endif
+
+//Trace interface, writes a Chrome trace of every scope and event on the host build
+#ifdef PSXF_TRACE
+	void Profiler_Event(ProfEvent event, const char *name, u32 size);
+	void *Profiler_TraceAlloc(size_t size);
+	void Profiler_TraceFree(void *ptr);
+#else
+	#define Profiler_Event(event, name, size)
+#endif
+
+#endif
@@ -14,6 +14,8 @@
 #include "../timer.h"
 #include "../io.h"
 #include "../stage.h"
+#include "../main.h"
+#include "../log.h"
 
 //Audio constants
 #define SAMPLE_RATE 0x1000 //44100 Hz
@@ -25,8 +27,9 @@
 #define BUFFER_TIME FIXED_DEC(((BUFFER_SIZE * 28) / 16), 44100)
 
 #define BUFFER_START_ADDR 0x1010
-#define DUMMY_ADDR (BUFFER_START_ADDR + (CHUNK_SIZE_MAX * 2))
-#define ALLOC_START_ADDR (BUFFER_START_ADDR + (CHUNK_SIZE_MAX * 2) + 64)
+#define BUFFER_ADDR(x) (BUFFER_START_ADDR + CHUNK_SIZE * (x))
+#define DUMMY_ADDR (BUFFER_START_ADDR + (CHUNK_SIZE_MAX * audio_stream_chunks))
+#define ALLOC_START_ADDR (BUFFER_START_ADDR + (CHUNK_SIZE_MAX * audio_stream_chunks) + 64)
 
 //SPU registers
 typedef struct
@@ -59,7 +62,6 @@ typedef struct
 	{
 		Audio_StreamState_Stopped,
 		Audio_StreamState_Ini,
-		Audio_StreamState_Play,
 		Audio_StreamState_Playing,
 	} state;
 	boolean loops;
@@ -71,7 +73,12 @@ typedef struct
 	//SPU state
 	u32 spu_addr;
 	u32 spu_pos;
-	u32 spu_swap;
+	u8 spu_fill;  //Chunk being filled
+	u8 spu_play;  //Chunk being played
+	u8 spu_ready; //Chunks filled ahead of the one being played
+	
+	boolean cd_busy;
+	fixed_t cd_start; //When the chunk being filled was requested
 	
 	//Timing state
 	u32 timing_chunk;
@@ -89,65 +96,179 @@ typedef struct
 } Audio_StreamContext;
 
 static volatile Audio_StreamContext audio_streamcontext;
+static volatile Audio_StreamStats audio_streamstats;
+static u8 audio_stream_chunks = AUDIO_STREAM_CHUNKS_DEFAULT;
 static volatile u32 audio_alloc_ptr = 0;
 
-void Audio_StreamIRQ_SPU(void)
+//Song clock, follows the frame timer and is phase locked to the chunk being played
+#define CLOCK_SHIFT 8 //Extra precision so small corrections aren't lost
+#define CLOCK_GAIN  3 //Correct 1/8 of the error each frame
+#define CLOCK_SNAP  (BUFFER_TIME / 2)
+
+static struct
 {
-	//Disable SPU IRQ until we've finished streaming more data
-	SpuSetIRQ(SPU_OFF);
-	
-	//Don't run if stopped
-	if (audio_streamcontext.state == Audio_StreamState_Stopped)
-		return;
-	
-	//Update timing state
-	audio_streamcontext.timing_chunk++;
-	audio_streamcontext.timing_pos = (audio_streamcontext.timing_chunk << FIXED_SHIFT) * (BUFFER_SIZE / 16) / 1575;
-	audio_streamcontext.timinvoicetart = timer_sec;
-	
-	//Update addresses
-	if ((audio_streamcontext.spu_swap ^= 1) != 0)
-		audio_streamcontext.spu_addr = BUFFER_START_ADDR + CHUNK_SIZE;
-	else
-		audio_streamcontext.spu_addr = BUFFER_START_ADDR;
-	audio_streamcontext.spu_pos = 0;
+	boolean valid;
+	fixed_t sec; //timer_sec of the last update
+	s32 clock;
+	fixed_t jitter;
+} audio_clock;
+
+//Sounds in SPU RAM, so a voice knows how long its sound lasts
+#define AUDIO_SOUNDS 32
+
+static struct
+{
+	u32 addr, size;
+} audio_sounds[AUDIO_SOUNDS];
+static u8 audio_sounds_count;
+
+//Voice state, kept in RAM so allocation never has to read SPU registers
+#define VOICE_FIRST 4 //Channels 0-3 are reserved for streaming
+#define VOICE_COUNT 24
+
+static struct
+{
+	fixed_t end; //timer_sec the sound stops playing at
+	u32 age;     //When the voice was keyed on, for stealing the oldest one
+	u8 priority;
+} audio_voices[VOICE_COUNT];
+static u32 audio_voice_age;
+
+static void Audio_ResetVoices(void)
+{
+	for (int i = 0; i < VOICE_COUNT; i++)
+	{
+		audio_voices[i].end = 0;
+		audio_voices[i].age = 0;
+		audio_voices[i].priority = 0;
+	}
+}
+
+//Mus prefetching
+typedef struct
+{
+	const char *want; //Mus to locate on the next load
+	const char *path; //Mus the located file belongs to
+	CdlFILE file;
 	
-	for (int i = 0; i < audio_streamcontext.header.s.channels; i++)
-		SPU_CHANNELS[i].loop_addr = SPU_RAM_ADDR(audio_streamcontext.spu_addr + BUFFER_SIZE * i);
+	enum
+	{
+		Audio_PrefetchState_None,
+		Audio_PrefetchState_Found,
+		Audio_PrefetchState_Reading,
+		Audio_PrefetchState_Ready,
+	} state;
 	
+	u8 header[2048];
+} Audio_Prefetch;
+
+static volatile Audio_Prefetch audio_prefetch;
+
+static boolean Audio_StreamFill(boolean reading)
+{
 	//Check for loop
-	if (audio_streamcontext.loops)
+	boolean seek = !reading;
+	if (audio_streamcontext.cd_pos >= audio_streamcontext.cd_length)
 	{
-		//Return to beginning of mus
-		if (audio_streamcontext.cd_pos >= audio_streamcontext.cd_length)
+		if (audio_streamcontext.loops)
 		{
+			//Return to beginning of mus
 			audio_streamcontext.timing_pos = 0;
 			audio_streamcontext.cd_pos = 0;
+			seek = true;
 		}
-	}
-	else
-	{
-		//Stop playing
-		if (audio_streamcontext.cd_pos == audio_streamcontext.cd_length)
+		else
 		{
-			//Continue streaming from CD (wrap to prevent unintended errors)
-			CdlLOC pos;
-			CdIntToPos(audio_streamcontext.cd_lba, &pos);
-			CdControlF(CdlReadN, (u8*)&pos);
-			return;
+			//The drive has nothing left to stream, read the prefetched mus' header meanwhile
+			//(only once it's paused, so no stray mus sector ends up as the header)
+			if (reading)
+			{
+				CdControlF(CdlPause, NULL);
+			}
+			else if (audio_prefetch.state == Audio_PrefetchState_Found)
+			{
+				audio_prefetch.state = Audio_PrefetchState_Reading;
+				CdControlF(CdlReadN, (u8*)&audio_prefetch.file.pos);
+			}
+			return false;
 		}
-		else if (audio_streamcontext.cd_pos > audio_streamcontext.cd_length)
+	}
+	
+	//Fill the chunk following the ones that are already filled
+	audio_streamcontext.spu_fill = (audio_streamcontext.spu_play + audio_streamcontext.spu_ready + 1) % audio_stream_chunks;
+	audio_streamcontext.spu_addr = BUFFER_ADDR(audio_streamcontext.spu_fill);
+	audio_streamcontext.spu_pos = 0;
+	
+	audio_streamcontext.cd_busy = true;
+	audio_streamcontext.cd_start = timer_sec;
+	
+	//Continue streaming from CD
+	if (seek)
+	{
+		CdlLOC pos;
+		CdIntToPos(audio_streamcontext.cd_lba + audio_streamcontext.cd_pos, &pos);
+		CdControlF(CdlReadN, (u8*)&pos);
+	}
+	return true;
+}
+
+static void Audio_StreamArmIRQ(void)
+{
+	//Don't arm the IRQ on a chunk that's being filled, the DMA would set it off
+	//(Audio_StreamIRQ_CD checks if playback got there first once the fill completes)
+	u8 next = (audio_streamcontext.spu_play + 1) % audio_stream_chunks;
+	if (audio_streamcontext.cd_busy && audio_streamcontext.spu_fill == next)
+		return;
+	SpuSetIRQAddr(BUFFER_ADDR(next));
+	SpuSetIRQ(SPU_ON);
+}
+
+static void Audio_StreamAdvance(fixed_t start)
+{
+	//Update timing state
+	audio_streamcontext.timing_chunk++;
+	audio_streamcontext.timing_pos = (audio_streamcontext.timing_chunk << FIXED_SHIFT) * (BUFFER_SIZE / 16) / 1575;
+	audio_streamcontext.timinvoicetart = start;
+	
+	//Continue into the chunk after the one now playing
+	audio_streamcontext.spu_play = (audio_streamcontext.spu_play + 1) % audio_stream_chunks;
+	u32 next_addr = BUFFER_ADDR((audio_streamcontext.spu_play + 1) % audio_stream_chunks);
+	for (int i = 0; i < audio_streamcontext.header.s.channels; i++)
+		SPU_CHANNELS[i].loop_addr = SPU_RAM_ADDR(next_addr + BUFFER_SIZE * i);
+}
+
+void Audio_StreamIRQ_SPU(void)
+{
+	//Disable SPU IRQ until the next chunk has been set up
+	SpuSetIRQ(SPU_OFF);
+	
+	//Don't run if stopped
+	if (audio_streamcontext.state == Audio_StreamState_Stopped)
+		return;
+	
+	//Check if the chunk we've reached was filled in time
+	if (audio_streamcontext.spu_ready == 0)
+	{
+		//Stop playing if there's nothing left to stream
+		if (!audio_streamcontext.loops && !audio_streamcontext.cd_busy && audio_streamcontext.cd_pos >= audio_streamcontext.cd_length)
 		{
-			//Stop playing
 			Audio_StopMus();
 			return;
 		}
+		audio_streamstats.underruns++;
+	}
+	else
+	{
+		audio_streamcontext.spu_ready--;
 	}
+	Audio_StreamAdvance(timer_sec);
 	
-	//Continue streaming from CD
-	CdlLOC pos;
-	CdIntToPos(audio_streamcontext.cd_lba + audio_streamcontext.cd_pos, &pos);
-	CdControlF(CdlReadN, (u8*)&pos);
+	//Refill the chunk that just finished playing
+	if (audio_streamcontext.cd_busy)
+		audio_streamstats.late_refills++;
+	else
+		Audio_StreamFill(false);
+	Audio_StreamArmIRQ();
 }
 
 static u8 read_sector[2048];
@@ -167,6 +288,15 @@ void Audio_StreamIRQ_CD(u8 event, u8 *payload)
 	if (event != CdlDataReady)
 		return;
 	
+	//Keep prefetched header
+	if (audio_prefetch.state == Audio_PrefetchState_Reading)
+	{
+		CdGetSector((u8*)audio_prefetch.header, 2048 / 4);
+		CdControlF(CdlPause, NULL);
+		audio_prefetch.state = Audio_PrefetchState_Ready;
+		return;
+	}
+	
 	//Fetch the sector that has been read from the drive
 	CdGetSector(read_sector, 2048 / 4);
 	audio_streamcontext.cd_pos++;
@@ -178,44 +308,61 @@ void Audio_StreamIRQ_CD(u8 event, u8 *payload)
 	
 	SpuWrite(read_sector, 2048);
 	
-	//Start SPU IRQ if finished reading
-	if (audio_streamcontext.spu_pos >= CHUNK_SIZE)
+	//Check if the chunk has been filled
+	if (audio_streamcontext.spu_pos < CHUNK_SIZE)
+		return;
+	
+	audio_streamcontext.cd_busy = false;
+	switch (audio_streamcontext.state)
 	{
-		switch (audio_streamcontext.state)
+		case Audio_StreamState_Ini:
 		{
-			case Audio_StreamState_Ini:
-			{
-				//Update addresses
-				audio_streamcontext.spu_addr = BUFFER_START_ADDR + CHUNK_SIZE;
-				audio_streamcontext.spu_swap = 1;
-				audio_streamcontext.spu_pos = 0;
-				
-				//Set state
-				audio_streamcontext.state = Audio_StreamState_Play;
+			//Fill the whole ring before playing
+			audio_streamcontext.spu_ready++;
+			if (audio_streamcontext.spu_ready < audio_stream_chunks && Audio_StreamFill(true))
 				break;
-			}
-			case Audio_StreamState_Play:
+			
+			//Stop and turn on SPU IRQ
+			CdControlF(CdlPause, NULL);
+			SpuSetIRQAddr(BUFFER_ADDR(1));
+			SpuSetIRQ(SPU_ON);
+			
+			//Set state
+			audio_streamcontext.state = Audio_StreamState_Playing;
+			break;
+		}
+		case Audio_StreamState_Playing:
+		{
+			//Track how long the refill took
+			fixed_t latency = timer_sec - audio_streamcontext.cd_start;
+			if (latency > audio_streamstats.max_latency)
+				audio_streamstats.max_latency = latency;
+			
+			//The IRQ wasn't armed on this chunk while it was filled, if its turn has come
+			//playback already ran into it before it was ready
+			if (audio_streamcontext.spu_fill == (audio_streamcontext.spu_play + 1) % audio_stream_chunks &&
+			    audio_streamcontext.timinvoicetart >= 0 &&
+			    timer_sec - audio_streamcontext.timinvoicetart >= BUFFER_TIME)
 			{
-				//Stop and turn on SPU IRQ
-				CdControlF(CdlPause, NULL);
-				SpuSetIRQAddr(audio_streamcontext.spu_addr);
-				SpuSetIRQ(SPU_ON);
-				
-				//Set state
-				audio_streamcontext.state = Audio_StreamState_Playing;
-				break;
+				audio_streamstats.underruns++;
+				audio_streamstats.late_refills++;
+				Audio_StreamAdvance(audio_streamcontext.timinvoicetart + BUFFER_TIME);
 			}
-			case Audio_StreamState_Playing:
-			{
-				//Stop and turn on SPU IRQ
+			
+			//A chunk that's already playing doesn't count as filled ahead
+			if (audio_streamcontext.spu_fill != audio_streamcontext.spu_play)
+				audio_streamcontext.spu_ready++;
+			
+			//Keep reading while there are free chunks
+			if (audio_streamcontext.spu_ready + 1 < audio_stream_chunks)
+				Audio_StreamFill(true);
+			else
 				CdControlF(CdlPause, NULL);
-				SpuSetIRQAddr(audio_streamcontext.spu_addr);
-				SpuSetIRQ(SPU_ON);
-				break;
-			}
-			default:
-				break;
+			Audio_StreamArmIRQ();
+			break;
 		}
+		default:
+			break;
 	}
 }
 
@@ -267,18 +414,52 @@ void Audio_Reset(void)
 	}
 	SPU_KEY_OFF |= 0x00FFFFFF;
 	SPU_KEY_ON |= 0x00FFFFFF;
+	Audio_ResetVoices();
 }
 
-void Audio_LoadMusFile(CdlFILE *file)
+void Audio_SetStreamChunks(u8 chunks)
+{
+	//Clamp ring depth
+	if (chunks == 0)
+		chunks = AUDIO_STREAM_CHUNKS_DEFAULT;
+	else if (chunks < AUDIO_STREAM_CHUNKS_MIN)
+		chunks = AUDIO_STREAM_CHUNKS_MIN;
+	else if (chunks > AUDIO_STREAM_CHUNKS_MAX)
+		chunks = AUDIO_STREAM_CHUNKS_MAX;
+	
+	//Move the dummy block and sound allocations past the new ring
+	Audio_StopMus();
+	audio_stream_chunks = chunks;
+	Audio_Reset();
+	Audio_ClearAlloc();
+}
+
+fixed_t Audio_GetStreamHeadroom(void)
+{
+	//How long the drive can stall before the ring runs dry
+	return BUFFER_TIME * (audio_stream_chunks - 1);
+}
+
+void Audio_GetStreamStats(Audio_StreamStats *stats)
+{
+	stats->underruns = audio_streamstats.underruns;
+	stats->late_refills = audio_streamstats.late_refills;
+	stats->max_latency = audio_streamstats.max_latency;
+}
+
+static void Audio_StreamMusFile(CdlFILE *file, boolean header)
 {
 	//Stop playing mus
 	Audio_StopMus();
 	
-	//Read header
+	//Read header if it hasn't been prefetched
 	CdReadyCallback(NULL);
-	CdControl(CdlSetloc, (u8*)&file->pos, NULL);
-	CdRead(1, (IO_Data)audio_streamcontext.header.d, CdlModeSpeed);
-	CdReadSync(0, NULL);
+	if (!header)
+	{
+		CdControl(CdlSetloc, (u8*)&file->pos, NULL);
+		CdRead(1, (IO_Data)audio_streamcontext.header.d, CdlModeSpeed);
+		CdReadSync(0, NULL);
+	}
 	
 	//Reset context
 	audio_streamcontext.state = Audio_StreamState_Ini;
@@ -287,9 +468,18 @@ void Audio_LoadMusFile(CdlFILE *file)
 	audio_streamcontext.timing_pos = 0;
 	audio_streamcontext.timinvoicetart = -1;
 	
-	audio_streamcontext.spu_addr = BUFFER_START_ADDR;
-	audio_streamcontext.spu_swap = 0;
+	audio_streamcontext.spu_addr = BUFFER_ADDR(0);
 	audio_streamcontext.spu_pos = 0;
+	audio_streamcontext.spu_fill = 0;
+	audio_streamcontext.spu_play = audio_stream_chunks - 1; //So the first fill lands in chunk 0
+	audio_streamcontext.spu_ready = 0;
+	
+	audio_streamcontext.cd_busy = true;
+	audio_streamcontext.cd_start = timer_sec;
+	
+	audio_streamstats.underruns = 0;
+	audio_streamstats.late_refills = 0;
+	audio_streamstats.max_latency = 0;
 	
 	//Use mus file
 	audio_streamcontext.cd_lba = CdPosToInt(&file->pos) + 1;
@@ -312,14 +502,46 @@ void Audio_LoadMusFile(CdlFILE *file)
 	CdControlF(CdlReadN, (u8*)&pos);
 }
 
+void Audio_LoadMusFile(CdlFILE *file)
+{
+	Audio_StreamMusFile(file, false);
+}
+
 void Audio_LoadMus(const char *path)
 {
-	//Find requested file
+	//Use the prefetched location and header if this is the prefetched mus
 	CdlFILE file;
-	IO_FindFile(&file, path);
+	boolean found = audio_prefetch.state != Audio_PrefetchState_None && strcmp(audio_prefetch.path, path) == 0;
+	boolean header = found && audio_prefetch.state == Audio_PrefetchState_Ready;
+	if (found)
+		file = *((CdlFILE*)&audio_prefetch.file);
+	if (header)
+		memcpy((u8*)audio_streamcontext.header.d, (u8*)audio_prefetch.header, sizeof(audio_prefetch.header));
+	audio_prefetch.state = Audio_PrefetchState_None;
+	
+	//Find requested file
+	if (!found)
+		IO_FindFile(&file, path);
+	
+	//Locate the mus to prefetch while the drive isn't streaming yet
+	if (audio_prefetch.want != NULL)
+	{
+		if (CdSearchFile((CdlFILE*)&audio_prefetch.file, (char*)audio_prefetch.want))
+		{
+			audio_prefetch.path = audio_prefetch.want;
+			audio_prefetch.state = Audio_PrefetchState_Found;
+		}
+		audio_prefetch.want = NULL;
+	}
 	
 	//Load found file
-	Audio_LoadMusFile(&file);
+	Audio_StreamMusFile(&file, header);
+}
+
+void Audio_PrefetchMus(const char *path)
+{
+	//Locate the mus on the next load, then read its header once the loaded mus has finished streaming
+	audio_prefetch.want = path;
 }
 
 void Audio_PlayMus(boolean loops)
@@ -332,15 +554,18 @@ void Audio_PlayMus(boolean loops)
 	audio_streamcontext.timing_chunk = 0;
 	audio_streamcontext.timing_pos = 0;
 	audio_streamcontext.timinvoicetart = timer_sec;
+	audio_clock.valid = false;
 	
 	//Play keys
 	audio_streamcontext.loops = loops;
+	audio_streamcontext.spu_play = 0;
+	audio_streamcontext.spu_ready--;
 	
 	u16 key_or = 0;
 	for (int i = 0; i < audio_streamcontext.header.s.channels; i++)
 	{
-		SPU_CHANNELS[i].addr       = SPU_RAM_ADDR(BUFFER_START_ADDR + BUFFER_SIZE * i);
-		SPU_CHANNELS[i].loop_addr  = SPU_CHANNELS[i].addr + SPU_RAM_ADDR(CHUNK_SIZE);
+		SPU_CHANNELS[i].addr       = SPU_RAM_ADDR(BUFFER_ADDR(0) + BUFFER_SIZE * i);
+		SPU_CHANNELS[i].loop_addr  = SPU_RAM_ADDR(BUFFER_ADDR(1) + BUFFER_SIZE * i);
 		SPU_CHANNELS[i].freq       = SAMPLE_RATE;
 		SPU_CHANNELS[i].adsr_param = 0x1fc080ff;
 		key_or |= (1 << i);
@@ -363,6 +588,7 @@ void Audio_StopMus(void)
 	}
 	SPU_KEY_OFF |= 0x00FFFFFF;
 	SPU_KEY_ON |= 0x00FFFFFF;
+	Audio_ResetVoices();
 	
 	//Reset SPU
 	SpuSetIRQCallback(NULL);
@@ -371,6 +597,10 @@ void Audio_StopMus(void)
 	//Reset CD
 	CdReadyCallback(NULL);
 	CdControlF(CdlPause, NULL);
+	
+	//An interrupted prefetch has to be read again
+	if (audio_prefetch.state == Audio_PrefetchState_Reading)
+		audio_prefetch.state = Audio_PrefetchState_Found;
 }
 
 void Audio_SetVolume(u8 i, u16 vol_left, u16 vol_right)
@@ -379,16 +609,67 @@ void Audio_SetVolume(u8 i, u16 vol_left, u16 vol_right)
 	SPU_CHANNELS[i].vol_right = vol_right;
 }
 
-fixed_t Audio_GetTime(void)
+static fixed_t Audio_GetChunkTime(void)
 {
-	if (audio_streamcontext.timing_pos < 0 || audio_streamcontext.timinvoicetart < 0)
-		return 0;
+	//Get time from the chunk being played, only as precise as the frame the chunk started on
 	fixed_t dt = timer_sec - audio_streamcontext.timinvoicetart;
 	if (dt > BUFFER_TIME)
 		return audio_streamcontext.timing_pos + BUFFER_TIME;
 	return audio_streamcontext.timing_pos + dt;
 }
 
+fixed_t Audio_GetTime(void)
+{
+	if (audio_streamcontext.timing_pos < 0 || audio_streamcontext.timinvoicetart < 0)
+	{
+		audio_clock.valid = false;
+		return 0;
+	}
+	
+	//Only advance once per frame
+	if (audio_clock.valid && audio_clock.sec == timer_sec)
+		return audio_clock.clock >> CLOCK_SHIFT;
+	
+	s32 target = Audio_GetChunkTime() << CLOCK_SHIFT;
+	if (!audio_clock.valid)
+	{
+		//Lock onto the audio
+		audio_clock.valid = true;
+		audio_clock.clock = target;
+		audio_clock.jitter = 0;
+	}
+	else
+	{
+		//Run on the frame timer and pull towards the audio
+		s32 clock = audio_clock.clock + ((timer_sec - audio_clock.sec) << CLOCK_SHIFT);
+		s32 error = target - clock;
+		if (error > (CLOCK_SNAP << CLOCK_SHIFT) || error < -(CLOCK_SNAP << CLOCK_SHIFT))
+		{
+			//Too far off to be drift (the mus looped or the game stalled), jump to the audio
+			audio_clock.clock = target;
+		}
+		else
+		{
+			//Correct part of the error and never run backwards
+			clock += error >> CLOCK_GAIN;
+			if (clock > audio_clock.clock)
+				audio_clock.clock = clock;
+			
+			//Average how far the audio was off
+			fixed_t abs_error = ((error < 0) ? -error : error) >> CLOCK_SHIFT;
+			audio_clock.jitter += (abs_error - audio_clock.jitter) >> 4;
+		}
+	}
+	audio_clock.sec = timer_sec;
+	
+	return audio_clock.clock >> CLOCK_SHIFT;
+}
+
+fixed_t Audio_GetTimeJitter(void)
+{
+	return audio_clock.jitter;
+}
+
 boolean Audio_IsPlaying(void)
 {
 	return audio_streamcontext.state != Audio_StreamState_Stopped;
@@ -404,6 +685,7 @@ boolean Audio_IsPlaying(void)
 
 void Audio_ClearAlloc(void) {
 	audio_alloc_ptr = ALLOC_START_ADDR;
+	audio_sounds_count = 0;
 }
 
 u32 Audio_LoadVAGData(u32 *sound, u32 sound_size) {
@@ -420,9 +702,8 @@ u32 Audio_LoadVAGData(u32 *sound, u32 sound_size) {
 	audio_alloc_ptr += xfer_size;
 
 	if (audio_alloc_ptr > 0x80000) {
-		// TODO: add proper error handling code
-		printf("FATAL: SPU RAM overflow! (%d bytes overflowing)\n", audio_alloc_ptr - 0x80000);
-		while (1);
+		sprintf(error_msg, "[Audio_LoadVAGData] SPU RAM overflow (%d bytes)", audio_alloc_ptr - 0x80000);
+		ErrorLock();
 	}
 
 	SpuSetTransferStartAddr(addr); // set transfer starting address to malloced area
@@ -430,32 +711,78 @@ u32 Audio_LoadVAGData(u32 *sound, u32 sound_size) {
 	SpuWrite(((u8 *)data + VAG_HEADER_SIZE), xfer_size); // perform actual transfer
 	SpuIsTransferCompleted(SPU_TRANSFER_WAIT); // wait for DMA to complete
 
-	printf("Allocated new sound (addr=%08x, size=%d)\n", addr, xfer_size);
+	// remember the sound's length
+	if (audio_sounds_count < AUDIO_SOUNDS) {
+		audio_sounds[audio_sounds_count].addr = addr;
+		audio_sounds[audio_sounds_count].size = xfer_size;
+		audio_sounds_count++;
+	}
+
+	LOG_TRACE(LOG_AUDIO, "Allocated new sound (addr=%08x, size=%d)", addr, xfer_size);
 	return addr;
 }
 
-void Audio_PlaySoundOnChannel(u32 addr, u32 channel) {
+static fixed_t Audio_GetSoundLength(u32 addr, u16 pitch) {
+	// 16 byte ADPCM blocks hold 28 samples each, played at 44100 Hz for pitch 0x1000
+	for (int i = 0; pitch != 0 && i < audio_sounds_count; i++) {
+		if (audio_sounds[i].addr != addr)
+			continue;
+		u32 samples = (audio_sounds[i].size / 16) * 28;
+		return (fixed_t)(((samples << FIXED_SHIFT) / 44100) * 0x1000 / pitch);
+	}
+
+	// unknown (or paused) sounds hold their voice until it's stolen
+	return 0x7FFFFFFF;
+}
+
+static void Audio_KeyOnVoice(u32 addr, u32 channel, u8 priority, u16 volume, u16 pitch) {
 	SPU_KEY_OFF |= (1 << channel);
 
-	SPU_CHANNELS[channel].vol_left   = 0x3fff;
-	SPU_CHANNELS[channel].vol_right  = 0x3fff;
+	SPU_CHANNELS[channel].vol_left   = volume;
+	SPU_CHANNELS[channel].vol_right  = volume;
 	SPU_CHANNELS[channel].addr       = SPU_RAM_ADDR(addr);
 	SPU_CHANNELS[channel].loop_addr  = SPU_RAM_ADDR(DUMMY_ADDR);
-	SPU_CHANNELS[channel].freq       = 0x1000; // 44100 Hz
+	SPU_CHANNELS[channel].freq       = pitch;
 	SPU_CHANNELS[channel].adsr_param = 0x1fc080ff;
 
 	SPU_KEY_ON |= (1 << channel);
+
+	// track voice
+	fixed_t length = Audio_GetSoundLength(addr, pitch);
+	audio_voices[channel].end = (length > 0x7FFFFFFF - timer_sec) ? 0x7FFFFFFF : (timer_sec + length);
+	audio_voices[channel].age = ++audio_voice_age;
+	audio_voices[channel].priority = priority;
 }
 
-void Audio_PlaySound(u32 addr) {
-	for (u32 ch = 4; ch < 24; ch++) { // channels 0-3 are reserved for streaming
-		if (SPU_CHANNELS[ch].loop_addr != SPU_RAM_ADDR(DUMMY_ADDR))
+void Audio_PlaySoundOnChannel(u32 addr, u32 channel) {
+	Audio_KeyOnVoice(addr, channel, AUDIO_PRIORITY_NORMAL, 0x3fff, 0x1000); // 44100 Hz
+}
+
+void Audio_PlaySoundEx(u32 addr, u8 priority, u16 volume, u16 pitch) {
+	// use a free voice, otherwise steal the oldest voice of the lowest priority not above ours
+	int pick = -1;
+	for (int ch = VOICE_FIRST; ch < VOICE_COUNT; ch++) {
+		if (audio_voices[ch].end <= timer_sec) {
+			pick = ch;
+			break;
+		}
+		if (audio_voices[ch].priority > priority)
 			continue;
+		if (pick < 0 ||
+		    audio_voices[ch].priority < audio_voices[pick].priority ||
+		    (audio_voices[ch].priority == audio_voices[pick].priority && audio_voices[ch].age < audio_voices[pick].age))
+			pick = ch;
+	}
 
-		printf("Playing sound on channel %d (addr=%08x)\n", ch, addr);
-		Audio_PlaySoundOnChannel(addr, ch);
+	if (pick < 0) {
+		LOG_TRACE(LOG_AUDIO, "Dropped sound, all voices are busy with higher priorities (addr=%08x)", addr);
 		return;
 	}
 
-	printf("Could not find free channel to play sound (addr=%08x)\n", addr);
+	LOG_TRACE(LOG_AUDIO, "Playing sound on channel %d (addr=%08x)", pick, addr);
+	Audio_KeyOnVoice(addr, pick, priority, volume, pitch);
+}
+
+void Audio_PlaySound(u32 addr) {
+	Audio_PlaySoundEx(addr, AUDIO_PRIORITY_NORMAL, 0x3fff, 0x1000);
 }
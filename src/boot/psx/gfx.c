@@ -8,6 +8,7 @@
 
 #include "../mem.h"
 #include "../main.h"
+#include "../profiler.h"
 
 //Gfx constants
 #define OTLEN 8
@@ -21,11 +22,72 @@ static u32 ot[2][OTLEN];    //Ordering table length
 static u8 pribuff[2][32768]; //Primitive buffer
 static u8 *nextpri;          //Next primitive pointer
 
+#ifdef PSXF_FILL
+	static Gfx_FillStats gfx_fill, gfx_fill_last;
+	static u8 gfx_fill_layer;
+	
+	static void Gfx_FillAdd(u32 pixels, boolean textured, u16 tpage, u8 blend)
+	{
+		u8 depth = textured ? ((tpage >> 7) & 0x3) : GFX_FILL_FLAT;
+		if (textured && depth == GFX_FILL_FLAT)
+			depth = 2; //Mode 3 also reads 15bpp
+		gfx_fill.pixels[depth][blend] += pixels;
+		gfx_fill.layer[gfx_fill_layer] += pixels;
+	}
+	
+	#define GFX_FILL_RECT(x, y, w, h, textured, tpage, blend) Gfx_FillAdd(Gfx_FillRectArea(x, y, w, h), textured, tpage, blend)
+	#define GFX_FILL_QUAD(p0, p1, p2, p3, textured, tpage, blend) Gfx_FillAdd(Gfx_FillQuadArea(p0, p1, p2, p3), textured, tpage, blend)
+#else
+	#define GFX_FILL_RECT(x, y, w, h, textured, tpage, blend)
+	#define GFX_FILL_QUAD(p0, p1, p2, p3, textured, tpage, blend)
+#endif
+
+#define GFX_BACKUP_MAX 8
+
+static struct
+{
+	RECT rect;
+	u32 *data;
+} gfx_backup[GFX_BACKUP_MAX];
+static u8 gfx_backups;
+static boolean gfx_backup_active, gfx_backup_lost;
+static u8 gfx_backup_clear[3];
+
+static void Gfx_BackupRect(const RECT *rect)
+{
+	if (!gfx_backup_active)
+		return;
+	
+	//Don't save the same area twice, the first copy is the one to restore
+	for (u8 i = 0; i < gfx_backups; i++)
+	{
+		const RECT *prev = &gfx_backup[i].rect;
+		if (rect->x >= prev->x && rect->y >= prev->y &&
+		    rect->x + rect->w <= prev->x + prev->w && rect->y + rect->h <= prev->y + prev->h)
+			return;
+	}
+	
+	//Read area back from VRAM
+	u32 *data;
+	if (gfx_backups >= GFX_BACKUP_MAX || (data = Mem_Alloc(rect->w * rect->h * 2)) == NULL)
+	{
+		gfx_backup_lost = true;
+		return;
+	}
+	StoreImage((RECT*)rect, data);
+	DrawSync(0);
+	
+	gfx_backup[gfx_backups].rect = *rect;
+	gfx_backup[gfx_backups].data = data;
+	gfx_backups++;
+}
+
 //Gfx functions
 void Gfx_Init(void)
 {
-	//Reset GPU
+	//Reset GPU and GTE
 	ResetGraph(0);
+	InitGeom();
 	
 	//Clear screen
 	RECT dst = {0, 0, 320, 480};
@@ -60,7 +122,11 @@ void Gfx_Init(void)
 	
 	//Load font
 	FntLoad(960, 0);
-	FntOpen(0, 8, 320, 224, 0, 100);
+	#ifdef PSXF_DEBUG
+		FntOpen(0, 8, 320, 224, 0, 512); //Room for the profiler and stage stats
+	#else
+		FntOpen(0, 8, 320, 224, 0, 100);
+	#endif
 	
 	//Initialize drawing state
 	nextpri = pribuff[0];
@@ -77,8 +143,10 @@ void Gfx_Quit(void)
 void Gfx_Flip(void)
 {
 	//Sync
+	Profiler_Begin(ProfScope_Flip);
 	DrawSync(0);
 	VSync(0);
+	Profiler_End(ProfScope_Flip);
 	
 	//Apply environments
 	PutDispEnv(&disp[db]);
@@ -95,6 +163,13 @@ void Gfx_Flip(void)
 	db ^= 1;
 	nextpri = pribuff[db];
 	ClearOTagR(ot[db], OTLEN);
+	
+	#ifdef PSXF_FILL
+		//Start counting the next frame
+		gfx_fill_last = gfx_fill;
+		memset(&gfx_fill, 0, sizeof(gfx_fill));
+		gfx_fill_layer = 0;
+	#endif
 }
 
 void Gfx_SetClear(u8 r, u8 g, u8 b)
@@ -141,6 +216,7 @@ void Gfx_LoadTex(Gfx_Tex *tex, IO_Data data, Gfx_LoadTex_Flag flag)
 			tex->tim_prect = *tparam.prect;
 			tex->tpage = getTPage(tparam.mode, 0, tparam.prect->x, tparam.prect->y);
 		}
+		Gfx_BackupRect(tparam.prect);
 		LoadImage(tparam.prect, (u32*)tparam.paddr);
 		DrawSync(0);
 	}
@@ -153,6 +229,7 @@ void Gfx_LoadTex(Gfx_Tex *tex, IO_Data data, Gfx_LoadTex_Flag flag)
 			tex->tim_crect = *tparam.crect;
 			tex->clut = getClut(tparam.crect->x, tparam.crect->y);
 		}
+		Gfx_BackupRect(tparam.crect);
 		LoadImage(tparam.crect, (u32*)tparam.caddr);
 		DrawSync(0);
 	}
@@ -172,6 +249,7 @@ void Gfx_DrawRect(const RECT *rect, u8 r, u8 g, u8 b)
 	
 	addPrim(ot[db], quad);
 	nextpri += sizeof(POLY_F4);
+	GFX_FILL_RECT(rect->x, rect->y, rect->w, rect->h, false, 0, 0);
 }
 
 void Gfx_BlendRect(const RECT *rect, u8 r, u8 g, u8 b, u8 mode)
@@ -185,6 +263,47 @@ void Gfx_BlendRect(const RECT *rect, u8 r, u8 g, u8 b, u8 mode)
 	
 	addPrim(ot[db], quad);
 	nextpri += sizeof(POLY_F4);
+	GFX_FILL_RECT(rect->x, rect->y, rect->w, rect->h, false, 0, 1 + mode);
+	
+	//Add tpage change (this controls transparency mode)
+	DR_TPAGE *tpage = (DR_TPAGE*)nextpri;
+	setDrawTPage(tpage, 0, 1, getTPage(0, mode, 0, 0));
+	
+	addPrim(ot[db], tpage);
+	nextpri += sizeof(DR_TPAGE);
+}
+
+void Gfx_DrawGradientRect(const RECT *rect, u8 r0, u8 g0, u8 b0, u8 r1, u8 g1, u8 b1)
+{
+	//Add gouraud quad, top edge coloured by rgb0 and bottom edge by rgb1
+	POLY_G4 *quad = (POLY_G4*)nextpri;
+	setPolyG4(quad);
+	setXYWH(quad, rect->x, rect->y, rect->w, rect->h);
+	setRGB0(quad, r0, g0, b0);
+	setRGB1(quad, r0, g0, b0);
+	setRGB2(quad, r1, g1, b1);
+	setRGB3(quad, r1, g1, b1);
+	
+	addPrim(ot[db], quad);
+	nextpri += sizeof(POLY_G4);
+	GFX_FILL_RECT(rect->x, rect->y, rect->w, rect->h, false, 0, 0);
+}
+
+void Gfx_BlendGradientRect(const RECT *rect, u8 r0, u8 g0, u8 b0, u8 r1, u8 g1, u8 b1, u8 mode)
+{
+	//Add gouraud quad
+	POLY_G4 *quad = (POLY_G4*)nextpri;
+	setPolyG4(quad);
+	setXYWH(quad, rect->x, rect->y, rect->w, rect->h);
+	setRGB0(quad, r0, g0, b0);
+	setRGB1(quad, r0, g0, b0);
+	setRGB2(quad, r1, g1, b1);
+	setRGB3(quad, r1, g1, b1);
+	setSemiTrans(quad, 1);
+	
+	addPrim(ot[db], quad);
+	nextpri += sizeof(POLY_G4);
+	GFX_FILL_RECT(rect->x, rect->y, rect->w, rect->h, false, 0, 1 + mode);
 	
 	//Add tpage change (this controls transparency mode)
 	DR_TPAGE *tpage = (DR_TPAGE*)nextpri;
@@ -207,6 +326,7 @@ void Gfx_BlitTexCol(Gfx_Tex *tex, const RECT *src, s32 x, s32 y, u8 r, u8 g, u8
 	
 	addPrim(ot[db], sprt);
 	nextpri += sizeof(SPRT);
+	GFX_FILL_RECT(x, y, src->w, src->h, true, tex->tpage, 0);
 	
 	//Add tpage change (TODO: reduce tpage changes)
 	DR_TPAGE *tpage = (DR_TPAGE*)nextpri;
@@ -255,6 +375,7 @@ void Gfx_DrawTexCol(Gfx_Tex *tex, const RECT *src, const RECT *dst, u8 r, u8 g,
 	
 	addPrim(ot[db], quad);
 	nextpri += sizeof(POLY_FT4);
+	GFX_FILL_RECT(cdst.x, cdst.y, cdst.w, cdst.h, true, tex->tpage, 0);
 }
 
 void Gfx_BlendTex(Gfx_Tex *tex, const RECT *src, const RECT *dst, u8 mode)
@@ -292,6 +413,9 @@ void Gfx_BlendTex(Gfx_Tex *tex, const RECT *src, const RECT *dst, u8 mode)
 	
 	addPrim(ot[db], quad);
 	nextpri += sizeof(POLY_FT4);
+	
+	//The flag only turns blending on, the texture's tpage picks the mode
+	GFX_FILL_RECT(cdst.x, cdst.y, cdst.w, cdst.h, true, tex->tpage, mode ? (1 + ((tex->tpage >> 5) & 0x3)) : 0);
 }
 
 void Gfx_DrawTex(Gfx_Tex *tex, const RECT *src, const RECT *dst)
@@ -312,6 +436,7 @@ void Gfx_DrawTexArbCol(Gfx_Tex *tex, const RECT *src, const POINT *p0, const POI
 	
 	addPrim(ot[db], quad);
 	nextpri += sizeof(POLY_FT4);
+	GFX_FILL_QUAD(p0, p1, p2, p3, true, tex->tpage, 0);
 }
 
 void Gfx_DrawTexArb(Gfx_Tex *tex, const RECT *src, const POINT *p0, const POINT *p1, const POINT *p2, const POINT *p3)
@@ -332,9 +457,61 @@ void Gfx_BlendTexArbCol(Gfx_Tex *tex, const RECT *src, const POINT *p0, const PO
 	
 	addPrim(ot[db], quad);
 	nextpri += sizeof(POLY_FT4);
+	
+	//Without the semi-transparency flag the GPU draws this opaque
+	GFX_FILL_QUAD(p0, p1, p2, p3, true, quad->tpage, 0);
 }
 
 void Gfx_BlendTexArb(Gfx_Tex *tex, const RECT *src, const POINT *p0, const POINT *p1, const POINT *p2, const POINT *p3, u8 mode)
 {
 	Gfx_BlendTexArbCol(tex, src, p0, p1, p2, p3, 0x80, 0x80, 0x80, mode);
 }
+
+#ifdef PSXF_FILL
+	void Gfx_SetFillLayer(u8 layer)
+	{
+		//Layers past the end are counted with the first
+		gfx_fill_layer = (layer < GFX_FILL_LAYERS) ? layer : 0;
+	}
+	
+	void Gfx_GetFillStats(Gfx_FillStats *stats)
+	{
+		*stats = gfx_fill_last;
+	}
+#endif
+
+void Gfx_BackupBegin(void)
+{
+	Gfx_BackupEnd();
+	gfx_backup_active = true;
+	gfx_backup_lost = false;
+	gfx_backup_clear[0] = draw[0].r0;
+	gfx_backup_clear[1] = draw[0].g0;
+	gfx_backup_clear[2] = draw[0].b0;
+}
+
+boolean Gfx_BackupRestore(void)
+{
+	if (!gfx_backup_active)
+		return false;
+	
+	//Restore newest first so overlapping areas end up with their oldest contents
+	for (u8 i = gfx_backups; i-- > 0;)
+	{
+		LoadImage(&gfx_backup[i].rect, gfx_backup[i].data);
+		DrawSync(0);
+	}
+	Gfx_SetClear(gfx_backup_clear[0], gfx_backup_clear[1], gfx_backup_clear[2]);
+	
+	boolean complete = !gfx_backup_lost;
+	Gfx_BackupEnd();
+	return complete;
+}
+
+void Gfx_BackupEnd(void)
+{
+	//Free saved areas
+	while (gfx_backups > 0)
+		Mem_Free(gfx_backup[--gfx_backups].data);
+	gfx_backup_active = false;
+}
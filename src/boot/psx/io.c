@@ -9,6 +9,8 @@
 #include "../mem.h"
 #include "../audio.h"
 #include "../main.h"
+#include "../log.h"
+#include "../profiler.h"
 
 //IO functions
 void IO_Init(void)
@@ -24,7 +26,7 @@ void IO_Quit(void)
 
 void IO_FindFile(CdlFILE *file, const char *path)
 {
-	printf("[IO_FindFile] Searching for %s\n", path);
+	LOG_INFO(LOG_IO, "[IO_FindFile] Searching for %s", path);
 	
 	//Stop playing mus
 	Audio_StopMus();
@@ -65,17 +67,19 @@ IO_Data IO_ReadFile(CdlFILE *file)
 	}
 	
 	//Read file
+	Profiler_Begin(ProfScope_IO);
 	CdReadyCallback(NULL);
 	CdControl(CdlSetloc, (u8*)&file->pos, NULL);
 	CdRead(sects, buffer, CdlModeSpeed);
 	CdReadSync(0, NULL);
+	Profiler_End(ProfScope_IO);
 	
 	return buffer;
 }
 
 IO_Data IO_Read(const char *path)
 {
-	printf("[IO_Read] Reading file %s\n", path);
+	LOG_INFO(LOG_IO, "[IO_Read] Reading file %s", path);
 	
 	//Search for file
 	CdlFILE file;
@@ -6,6 +6,8 @@
 
 #include "../pad.h"
 
+#include "../timer.h"
+
 //Pad state
 typedef struct
 {
@@ -20,24 +22,88 @@ typedef struct
 static u16 pad_buff[2][34/2];
 Pad pad_state, pad_state_2;
 
+//Press events, written every VSync and read on update
+#define PAD_RING 16 //Must be a power of 2
+#define PAD_EVENT_TIMEOUT FIXED_DEC(1,10) //Presses older than this were made while the game wasn't polling
+
+typedef struct
+{
+	u16 held;
+	struct
+	{
+		u16 press;
+		u32 count;
+	} ring[PAD_RING];
+	u8 head, tail;
+} Pad_Sampler;
+
+static volatile Pad_Sampler pad_sampler[2];
+static volatile u8 pad_vsyncs;
+static u8 pad_vsyncs_last;
+
 //Internal pad functions
-static void Pad_UpdateState(Pad *this, PADTYPE *pad)
+static boolean Pad_IsValid(PADTYPE *pad)
+{
+	//Check if a digital or analog pad is connected
+	return pad->stat == 0 && ((pad->type == 0x4) || (pad->type == 0x5) || (pad->type == 0x7));
+}
+
+static void Pad_Sample(volatile Pad_Sampler *this, PADTYPE *pad, u32 count)
+{
+	if (!Pad_IsValid(pad))
+		return;
+	
+	//Push newly pressed buttons, dropping them if the ring is full
+	u16 held = ~pad->btn;
+	u16 press = held & ~this->held;
+	this->held = held;
+	
+	if (press && ((this->head + 1) & (PAD_RING - 1)) != this->tail)
+	{
+		this->ring[this->head].press = press;
+		this->ring[this->head].count = count;
+		this->head = (this->head + 1) & (PAD_RING - 1);
+	}
+}
+
+static void Pad_VSync(void)
+{
+	//Sample pads with the time they were read at
+	u32 count = Timer_GetCount();
+	Pad_Sample(&pad_sampler[0], (PADTYPE*)pad_buff[0], count);
+	Pad_Sample(&pad_sampler[1], (PADTYPE*)pad_buff[1], count);
+	pad_vsyncs++;
+}
+
+static void Pad_UpdateEvents(Pad *this, volatile Pad_Sampler *sampler)
 {
-	if (pad->stat == 0)
+	//Take events sampled since the last update
+	this->events_count = 0;
+	while (sampler->tail != sampler->head)
 	{
-		//Read pad information
-		if ((pad->type == 0x4) ||
-			(pad->type == 0x5) ||
-			(pad->type == 0x7))
+		fixed_t age = Timer_GetCountAge(sampler->ring[sampler->tail].count);
+		if (age <= PAD_EVENT_TIMEOUT && this->events_count < PAD_EVENTS)
 		{
-			//Set pad state
-			this->press = (~pad->btn) & (~this->held);
-			this->held = ~pad->btn;
-			this->left_x  = pad->ls_x;
-			this->left_y  = pad->ls_y;
-			this->right_x = pad->rs_x;
-			this->right_y = pad->rs_y;
+			Pad_Event *event = &this->events[this->events_count++];
+			event->press = sampler->ring[sampler->tail].press;
+			event->age = age;
 		}
+		sampler->tail = (sampler->tail + 1) & (PAD_RING - 1);
+	}
+}
+
+static void Pad_UpdateState(Pad *this, PADTYPE *pad)
+{
+	//Read pad information
+	if (Pad_IsValid(pad))
+	{
+		//Set pad state
+		this->press = (~pad->btn) & (~this->held);
+		this->held = ~pad->btn;
+		this->left_x  = pad->ls_x;
+		this->left_y  = pad->ls_y;
+		this->right_x = pad->rs_x;
+		this->right_y = pad->rs_y;
 	}
 }
 
@@ -47,9 +113,11 @@ void Pad_Init(void)
 	//Clear pad states
 	pad_state.held = pad_state.press = 0;
 	pad_state.left_x = pad_state.left_y = pad_state.right_x = pad_state.right_y = 0;
+	pad_state.events_count = 0;
 	
 	pad_state_2.held = pad_state_2.press = 0;
 	pad_state_2.left_x = pad_state_2.left_y = pad_state_2.right_x = pad_state_2.right_y = 0;
+	pad_state_2.events_count = 0;
 	
 	//Initialize system pads
 	InitPAD((char*)pad_buff[0], 34, (char*)pad_buff[1], 34);
@@ -58,16 +126,26 @@ void Pad_Init(void)
 	StartPAD();
 	
 	ChangeClearPAD(NULL);
+	
+	//Sample presses every VSync
+	VSyncCallback(Pad_VSync);
 }
 
 void Pad_Quit(void)
 {
-	
+	VSyncCallback(NULL);
 }
 
 void Pad_Update(void)
 {
+	//Every frame waits for at least one VSync, if none was sampled the callback was cleared (ResetCallback before movies)
+	if (pad_vsyncs == pad_vsyncs_last)
+		VSyncCallback(Pad_VSync);
+	pad_vsyncs_last = pad_vsyncs;
+	
 	//Read pad states
 	Pad_UpdateState(&pad_state,   (PADTYPE*)pad_buff[0]);
 	Pad_UpdateState(&pad_state_2, (PADTYPE*)pad_buff[1]);
+	Pad_UpdateEvents(&pad_state,   &pad_sampler[0]);
+	Pad_UpdateEvents(&pad_state_2, &pad_sampler[1]);
 }
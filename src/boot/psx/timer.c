@@ -103,4 +103,18 @@ void Timer_Reset(void)
 {
 	Timer_Tick();
 	timer_dt = 0;
-}
\ No newline at end of file
+}
+
+u32 Timer_GetCount(void)
+{
+	return timer_count;
+}
+
+fixed_t Timer_GetCountAge(u32 count)
+{
+	//Get how long before the last tick the given count was read
+	//Without the counter IRQ the count only moves once a tick, so there's no age to give
+	if (timer_brokeconf >= 10 || count >= timer_lcount)
+		return 0;
+	return FIXED_DIV(timer_lcount - count, timer_persec);
+}
@@ -12,15 +12,18 @@
 #include "pad.h"
 #include "main.h"
 #include "random.h"
+#include "mutil.h"
 #include "movie.h"
 #include "network.h"
+#include "log.h"
+#include "profiler.h"
+#include "chart.h"
 
 #include "menu/menu.h"
 #include "trans.h"
 #include "loadscr.h"
 
 #include "object/combo.h"
-#include "object/splash.h"
 
 //Stage constants
 //#define STAGE_NOHUD //Disable the HUD
@@ -99,6 +102,21 @@ static  u8 note_anims[4][3] = {
 	{CharAnim_Right, CharAnim_RightAlt, PlayerAnim_RightMiss},
 };
 
+//Stage fill-rate layers
+typedef enum
+{
+	StageLayer_Other,
+	StageLayer_Trans,
+	StageLayer_BG,
+	StageLayer_MD,
+	StageLayer_FG,
+	StageLayer_Chars,
+	StageLayer_Objects,
+	StageLayer_HUD,
+	StageLayer_Notes,
+	StageLayer_Max,
+} StageLayer;
+
 //Stage state
 Stage stage;
 
@@ -213,46 +231,57 @@ static void Stage_ChangeBPM(u16 bpm, u16 step)
 	stage.early_sus_safe = stage.early_safe * 2 / 5;
 }
 
-static Section *Stage_GetPrevSection(Section *section)
+//Chart timing
+typedef struct
 {
-	if (section > stage.sections)
-		return section - 1;
-	return NULL;
-}
+	Section *section;
+	fixed_t time_base, step_crochet;
+	u16 step_base;
+} ChartTimer;
 
-static u16 Stage_GetSectionStart(Section *section)
+static void ChartTimer_Init(ChartTimer *this)
 {
-	Section *prev = Stage_GetPrevSection(section);
-	if (prev == NULL)
-		return 0;
-	return prev->end;
+	this->section = stage.sections;
+	this->time_base = 0;
+	this->step_base = 0;
+	this->step_crochet = ((fixed_t)(this->section->flag & SECTION_FLAG_BPM_MASK) << FIXED_SHIFT) * 8 / 240;
 }
 
-//Section scroll structure
-typedef struct
+static fixed_t ChartTimer_GetTime(ChartTimer *this, u16 pos)
 {
-	fixed_t start;   //Seconds
-	fixed_t length;  //Seconds
-	u16 start_step;  //Sub-steps
-	u16 length_step; //Sub-steps
-	
-	fixed_t size; //Note height
-} SectionScroll;
+	//Advance through sections the same way Stage_ChangeBPM does, so times match note_scroll
+	while (pos >= this->section->end)
+	{
+		u16 end = this->section->end;
+		this->section++;
+		this->time_base += FIXED_DIV(((fixed_t)end - this->step_base) << FIXED_SHIFT, this->step_crochet);
+		this->step_base = end;
+		this->step_crochet = ((fixed_t)(this->section->flag & SECTION_FLAG_BPM_MASK) << FIXED_SHIFT) * 8 / 240;
+	}
+	return this->time_base + FIXED_DIV(((fixed_t)pos - this->step_base) << FIXED_SHIFT, this->step_crochet);
+}
 
-static void Stage_GetSectionScroll(SectionScroll *scroll, Section *section)
+//HUD number functions
+static void Stage_SetDigits(StageDigits *this, s32 value, boolean append_zero)
 {
-	//Get BPM
-	u16 bpm = section->flag & SECTION_FLAG_BPM_MASK;
-	
-	//Get section step info
-	scroll->start_step = Stage_GetSectionStart(section);
-	scroll->length_step = section->end - scroll->start_step;
-	
-	//Get section time length
-	scroll->length = (scroll->length_step * FIXED_DEC(15,1) / 12) * 24 / bpm;
-	
-	//Get note height
-	scroll->size = FIXED_MUL(stage.speed, scroll->length * (12 * 150) / scroll->length_step) + FIXED_UNIT;
+	//Write digits right to left
+	u8 glyph[12];
+	u8 *p = glyph + sizeof(glyph);
+	
+	u32 uvalue = (value < 0) ? -value : value;
+	if (append_zero)
+		*--p = 80;
+	do
+	{
+		*--p = 80 + ((uvalue % 10) << 3);
+		uvalue /= 10;
+	} while (uvalue != 0);
+	if (value < 0)
+		*--p = 160;
+	
+	//Cache glyphs
+	this->len = (glyph + sizeof(glyph)) - p;
+	memcpy(this->glyph, p, this->len);
 }
 
 //Note hit detection
@@ -331,16 +360,12 @@ static u8 Stage_HitNote(PlayerState *this, u8 type, fixed_t offset)
 	if (hit_type == 0)
 	{
 		for (int i = 0; i < 3; i++)
-		{
-			//Create splash object
-			Obj_Splash *splash = Obj_Splash_New(
+			Particle_EmitSplash(
+				&stage.splashes,
 				stage.note_x[type],
 				stage.note_y[type] * (stage.downscroll ? -1 : 1),
 				type & 0x3
 			);
-			if (splash != NULL)
-				ObjectList_Add(&stage.objlist_splash, (Object*)splash);
-		}
 	}
 	
 	return hit_type;
@@ -372,7 +397,7 @@ static void Stage_MissNote(PlayerState *this)
 	}
 }
 
-static void Stage_NoteCheck(PlayerState *this, u8 type)
+static void Stage_NoteCheck(PlayerState *this, u8 type, fixed_t note_scroll)
 {
 	//Perform note check
 	for (Note *note = stage.cur_note;; note++)
@@ -381,9 +406,9 @@ static void Stage_NoteCheck(PlayerState *this, u8 type)
 		{
 			//Check if note can be hit
 			fixed_t note_fp = (fixed_t)note->pos << FIXED_SHIFT;
-			if (note_fp - stage.early_safe > stage.note_scroll)
+			if (note_fp - stage.early_safe > note_scroll)
 				break;
-			if (note_fp + stage.late_safe < stage.note_scroll)
+			if (note_fp + stage.late_safe < note_scroll)
 				continue;
 			if ((note->type & NOTE_FLAG_HIT) || (note->type & (NOTE_FLAG_OPPONENT | 0x3)) != type || (note->type & NOTE_FLAG_SUSTAIN))
 				continue;
@@ -396,7 +421,7 @@ static void Stage_NoteCheck(PlayerState *this, u8 type)
 			if (this->character->ignoreanim != true)
 		    this->character->set_anim(this->character, note_anims[type & 0x3][(note->type & NOTE_FLAG_ALT_ANIM) != 0]);
 
-			u8 hit_type = Stage_HitNote(this, type, stage.note_scroll - note_fp);
+			u8 hit_type = Stage_HitNote(this, type, note_scroll - note_fp);
 			this->arrow_hitan[type & 0x3] = stage.step_time;
 			
 				(void)hit_type;
@@ -406,9 +431,9 @@ static void Stage_NoteCheck(PlayerState *this, u8 type)
 		{
 			//Check if mine can be hit
 			fixed_t note_fp = (fixed_t)note->pos << FIXED_SHIFT;
-			if (note_fp - (stage.late_safe * 3 / 5) > stage.note_scroll)
+			if (note_fp - (stage.late_safe * 3 / 5) > note_scroll)
 				break;
-			if (note_fp + (stage.late_safe * 2 / 5) < stage.note_scroll)
+			if (note_fp + (stage.late_safe * 2 / 5) < note_scroll)
 				continue;
 			if ((note->type & NOTE_FLAG_HIT) || (note->type & (NOTE_FLAG_OPPONENT | 0x3)) != type || (note->type & NOTE_FLAG_SUSTAIN))
 				continue;
@@ -497,14 +522,33 @@ static void Stage_ProcessPlayer(PlayerState *this, Pad *pad, boolean playing)
 			if (this->pad_held & INPUT_RIGHT)
 				Stage_SustainCheck(this, 3 | i);
 			
-			if (this->pad_press & INPUT_LEFT)
-				Stage_NoteCheck(this, 0 | i);
-			if (this->pad_press & INPUT_DOWN)
-				Stage_NoteCheck(this, 1 | i);
-			if (this->pad_press & INPUT_UP)
-				Stage_NoteCheck(this, 2 | i);
-			if (this->pad_press & INPUT_RIGHT)
-				Stage_NoteCheck(this, 3 | i);
+			//Judge each press at the scroll it was made at
+			u16 sampled = 0;
+			const Pad_Event *event = pad->events;
+			for (u8 j = 0; j < pad->events_count; j++, event++)
+			{
+				fixed_t note_scroll = stage.note_scroll - FIXED_MUL(event->age, stage.step_crochet);
+				if (event->press & INPUT_LEFT)
+					Stage_NoteCheck(this, 0 | i, note_scroll);
+				if (event->press & INPUT_DOWN)
+					Stage_NoteCheck(this, 1 | i, note_scroll);
+				if (event->press & INPUT_UP)
+					Stage_NoteCheck(this, 2 | i, note_scroll);
+				if (event->press & INPUT_RIGHT)
+					Stage_NoteCheck(this, 3 | i, note_scroll);
+				sampled |= event->press;
+			}
+			
+			//Presses the VSync sampler missed are judged at this frame's scroll
+			u16 press = this->pad_press & ~sampled;
+			if (press & INPUT_LEFT)
+				Stage_NoteCheck(this, 0 | i, stage.note_scroll);
+			if (press & INPUT_DOWN)
+				Stage_NoteCheck(this, 1 | i, stage.note_scroll);
+			if (press & INPUT_UP)
+				Stage_NoteCheck(this, 2 | i, stage.note_scroll);
+			if (press & INPUT_RIGHT)
+				Stage_NoteCheck(this, 3 | i, stage.note_scroll);
 		}
 		else
 		{
@@ -564,7 +608,7 @@ static void Stage_ProcessPlayer(PlayerState *this, Pad *pad, boolean playing)
 				if (hit[j] & 1)
 				{
 					this->pad_press |= note_key[j];
-					Stage_NoteCheck(this, j | i);
+					Stage_NoteCheck(this, j | i, stage.note_scroll);
 				}
 			}
 			
@@ -591,10 +635,10 @@ void Stage_DrawTexCol(Gfx_Tex *tex, const RECT *src, const RECT_FIXED *dst, fixe
 			return;
 	#endif
 	
-	fixed_t l = (SCREEN_WIDTH2  << FIXED_SHIFT) + FIXED_MUL(xz, zoom);// + FIXED_DEC(1,2);
-	fixed_t t = (SCREEN_HEIGHT2 << FIXED_SHIFT) + FIXED_MUL(yz, zoom);// + FIXED_DEC(1,2);
-	fixed_t r = l + FIXED_MUL(wz, zoom);
-	fixed_t b = t + FIXED_MUL(hz, zoom);
+	fixed_t l = (SCREEN_WIDTH2  << FIXED_SHIFT) + Fixed_Mul(xz, zoom);// + FIXED_DEC(1,2);
+	fixed_t t = (SCREEN_HEIGHT2 << FIXED_SHIFT) + Fixed_Mul(yz, zoom);// + FIXED_DEC(1,2);
+	fixed_t r = l + Fixed_Mul(wz, zoom);
+	fixed_t b = t + Fixed_Mul(hz, zoom);
 	
 	l >>= FIXED_SHIFT;
 	t >>= FIXED_SHIFT;
@@ -615,6 +659,123 @@ void Stage_DrawTex(Gfx_Tex *tex, const RECT *src, const RECT_FIXED *dst, fixed_t
 	Stage_DrawTexCol(tex, src, dst, zoom, 0x80, 0x80, 0x80);
 }
 
+//Stage transform functions
+#ifndef PSXF_PC
+#define STAGE_GTE_H   256 //Projection plane distance
+#define STAGE_GTE_Z   (STAGE_GTE_H << MUTIL_ZOOM_SUB) //Depth the projection divides sub-pixels back out at
+
+static fixed_t stage_gte_zoom; //Zoom loaded into the GTE, 0 if it needs reloading
+
+static void Stage_GTESetZoom(fixed_t zoom)
+{
+	//Zoom goes in the rotation matrix diagonal, depth in the translation
+	if (zoom == stage_gte_zoom)
+		return;
+	stage_gte_zoom = zoom;
+	
+	MATRIX m = {
+		{
+			{zoom << (12 - FIXED_SHIFT), 0, 0},
+			{0, zoom << (12 - FIXED_SHIFT), 0},
+			{0, 0, ONE},
+		},
+		{0, 0, STAGE_GTE_Z}
+	};
+	SetRotMatrix(&m);
+	SetTransMatrix(&m);
+	SetGeomOffset(SCREEN_WIDTH2, SCREEN_HEIGHT2);
+	SetGeomScreen(STAGE_GTE_H);
+}
+
+static boolean Stage_GTEVector(SVECTOR *v, const POINT_FIXED *p)
+{
+	//Vectors are 16-bit, leave points that don't fit to the CPU
+	fixed_t x = p->x >> (FIXED_SHIFT - MUTIL_ZOOM_SUB);
+	fixed_t y = p->y >> (FIXED_SHIFT - MUTIL_ZOOM_SUB);
+	if (x < -0x8000 || x > 0x7FFF || y < -0x8000 || y > 0x7FFF)
+		return false;
+	v->vx = x;
+	v->vy = y;
+	v->vz = 0;
+	return true;
+}
+
+static boolean Stage_TransformPointsGTE(const POINT_FIXED *in, POINT *out, size_t n, fixed_t zoom)
+{
+	//Every point has to fit before any are transformed, so a batch never mixes paths
+	SVECTOR v[STAGE_BATCH_QUADS * 4 + 2];
+	if (n == 0 || n > STAGE_BATCH_QUADS * 4)
+		return false;
+	for (size_t i = 0; i < n; i++)
+		if (!Stage_GTEVector(&v[i], &in[i]))
+			return false;
+	
+	//Pad the last triple with copies of the last point
+	for (size_t i = n; i % 3 != 0; i++)
+		v[i] = v[n - 1];
+	
+	//Transform triples with RTPT
+	Stage_GTESetZoom(zoom);
+	for (size_t i = 0; i < n; i += 3)
+	{
+		long sxy[3], p, flag;
+		RotTransPers3(&v[i], &v[i + 1], &v[i + 2], &sxy[0], &sxy[1], &sxy[2], &p, &flag);
+		if (flag & (1 << 31))
+			return false; //Saturated, redo the whole batch on the CPU
+		
+		for (size_t j = 0; j < 3 && (i + j) < n; j++)
+		{
+			out[i + j].x = (s16)sxy[j];
+			out[i + j].y = (s16)(sxy[j] >> 16);
+		}
+	}
+	return true;
+}
+#endif
+
+void Stage_TransformPoints(const POINT_FIXED *in, POINT *out, size_t n, fixed_t zoom)
+{
+	//Use the GTE while the zoom fits in its matrix, otherwise the CPU
+	//Both paths round to the same pixels, so edges shared with other batches line up either way
+	#ifndef PSXF_PC
+		if (zoom > 0 && zoom < (8 << FIXED_SHIFT) && Stage_TransformPointsGTE(in, out, n, zoom))
+			return;
+	#endif
+	MUtil_ZoomPoints(in, out, n, zoom);
+}
+
+void Stage_DrawQuadBatch(Gfx_Tex *tex, const StageQuad *quad, size_t quads, fixed_t zoom, u8 r, u8 g, u8 b, u8 mode)
+{
+	//Don't draw if HUD and HUD is disabled
+	#ifdef STAGE_NOHUD
+		if (tex == &stage.tex_hud0 || tex == &stage.tex_hud1)
+			return;
+	#endif
+	
+	while (quads != 0)
+	{
+		//Gather points of the next group of quads and transform them together
+		POINT_FIXED p[STAGE_BATCH_QUADS * 4];
+		POINT s[STAGE_BATCH_QUADS * 4];
+		
+		size_t group = (quads > STAGE_BATCH_QUADS) ? STAGE_BATCH_QUADS : quads;
+		for (size_t i = 0; i < group; i++)
+			memcpy(&p[i << 2], quad[i].p, sizeof(quad[i].p));
+		Stage_TransformPoints(p, s, group << 2, zoom);
+		
+		//Draw quads
+		for (size_t i = 0; i < group; i++, quad++)
+		{
+			const POINT *qs = &s[i << 2];
+			if (mode == STAGE_QUAD_OPAQUE)
+				Gfx_DrawTexArbCol(tex, &quad->src, &qs[0], &qs[1], &qs[2], &qs[3], r, g, b);
+			else
+				Gfx_BlendTexArbCol(tex, &quad->src, &qs[0], &qs[1], &qs[2], &qs[3], r, g, b, mode);
+		}
+		quads -= group;
+	}
+}
+
 void Stage_DrawTexArbCol(Gfx_Tex *tex, const RECT *src, const POINT_FIXED *p0, const POINT_FIXED *p1, const POINT_FIXED *p2, const POINT_FIXED *p3, u8 r, u8 g, u8 b, fixed_t zoom)
 {
 	//Don't draw if HUD and HUD is disabled
@@ -624,12 +785,11 @@ void Stage_DrawTexArbCol(Gfx_Tex *tex, const RECT *src, const POINT_FIXED *p0, c
 	#endif
 	
 	//Get screen-space points
-	POINT s0 = {SCREEN_WIDTH2 + (FIXED_MUL(p0->x, zoom) >> FIXED_SHIFT), SCREEN_HEIGHT2 + (FIXED_MUL(p0->y, zoom) >> FIXED_SHIFT)};
-	POINT s1 = {SCREEN_WIDTH2 + (FIXED_MUL(p1->x, zoom) >> FIXED_SHIFT), SCREEN_HEIGHT2 + (FIXED_MUL(p1->y, zoom) >> FIXED_SHIFT)};
-	POINT s2 = {SCREEN_WIDTH2 + (FIXED_MUL(p2->x, zoom) >> FIXED_SHIFT), SCREEN_HEIGHT2 + (FIXED_MUL(p2->y, zoom) >> FIXED_SHIFT)};
-	POINT s3 = {SCREEN_WIDTH2 + (FIXED_MUL(p3->x, zoom) >> FIXED_SHIFT), SCREEN_HEIGHT2 + (FIXED_MUL(p3->y, zoom) >> FIXED_SHIFT)};
+	POINT_FIXED p[4] = {*p0, *p1, *p2, *p3};
+	POINT s[4];
+	Stage_TransformPoints(p, s, 4, zoom);
 	
-	Gfx_DrawTexArbCol(tex, src, &s0, &s1, &s2, &s3, r, g, b);
+	Gfx_DrawTexArbCol(tex, src, &s[0], &s[1], &s[2], &s[3], r, g, b);
 }
 
 void Stage_DrawTexArb(Gfx_Tex *tex, const RECT *src, const POINT_FIXED *p0, const POINT_FIXED *p1, const POINT_FIXED *p2, const POINT_FIXED *p3, fixed_t zoom)
@@ -646,12 +806,11 @@ void Stage_BlendTexArbCol(Gfx_Tex *tex, const RECT *src, const POINT_FIXED *p0,
 	#endif
 	
 	//Get screen-space points
-	POINT s0 = {SCREEN_WIDTH2 + (FIXED_MUL(p0->x, zoom) >> FIXED_SHIFT), SCREEN_HEIGHT2 + (FIXED_MUL(p0->y, zoom) >> FIXED_SHIFT)};
-	POINT s1 = {SCREEN_WIDTH2 + (FIXED_MUL(p1->x, zoom) >> FIXED_SHIFT), SCREEN_HEIGHT2 + (FIXED_MUL(p1->y, zoom) >> FIXED_SHIFT)};
-	POINT s2 = {SCREEN_WIDTH2 + (FIXED_MUL(p2->x, zoom) >> FIXED_SHIFT), SCREEN_HEIGHT2 + (FIXED_MUL(p2->y, zoom) >> FIXED_SHIFT)};
-	POINT s3 = {SCREEN_WIDTH2 + (FIXED_MUL(p3->x, zoom) >> FIXED_SHIFT), SCREEN_HEIGHT2 + (FIXED_MUL(p3->y, zoom) >> FIXED_SHIFT)};
+	POINT_FIXED p[4] = {*p0, *p1, *p2, *p3};
+	POINT s[4];
+	Stage_TransformPoints(p, s, 4, zoom);
 	
-	Gfx_BlendTexArbCol(tex, src, &s0, &s1, &s2, &s3, r, g, b, mode);
+	Gfx_BlendTexArbCol(tex, src, &s[0], &s[1], &s[2], &s[3], r, g, b, mode);
 }
 
 void Stage_BlendTexArb(Gfx_Tex *tex, const RECT *src, const POINT_FIXED *p0, const POINT_FIXED *p1, const POINT_FIXED *p2, const POINT_FIXED *p3, fixed_t zoom, u8 mode)
@@ -659,6 +818,47 @@ void Stage_BlendTexArb(Gfx_Tex *tex, const RECT *src, const POINT_FIXED *p0, con
 	Stage_BlendTexArbCol(tex, src, p0, p1, p2, p3, zoom, 0x80, 0x80, 0x80, mode);
 }
 
+//Stage debug functions
+#ifdef PSXF_DEBUG
+static void Stage_PrintFill(void)
+{
+	//Print last frame's overdraw in tenths of a screen, per layer then per texture depth
+	static const char *layer_name[StageLayer_Max] = {"ot", "tr", "bg", "md", "fg", "ch", "ob", "hd", "nt"};
+	static const char *depth_name[GFX_FILL_DEPTHS] = {"4b", "8b", "15b", "fl"};
+	const u32 screen = SCREEN_WIDTH * SCREEN_HEIGHT;
+	
+	Gfx_FillStats fill;
+	Gfx_GetFillStats(&fill);
+	
+	u32 total = 0;
+	FntPrint("\nfill");
+	for (u8 i = 0; i < StageLayer_Max; i++)
+	{
+		if (fill.layer[i] == 0)
+			continue;
+		u32 ratio = fill.layer[i] * 10 / screen;
+		FntPrint(" %s%d.%d", layer_name[i], ratio / 10, ratio % 10);
+		total += fill.layer[i];
+	}
+	total = total * 10 / screen;
+	FntPrint(" =%d.%dx\n", total / 10, total % 10);
+	
+	u32 semi = 0;
+	for (u8 i = 0; i < GFX_FILL_DEPTHS; i++)
+	{
+		u32 depth = 0;
+		for (u8 j = 0; j < GFX_FILL_BLENDS; j++)
+			depth += fill.pixels[i][j];
+		for (u8 j = 1; j < GFX_FILL_BLENDS; j++)
+			semi += fill.pixels[i][j];
+		depth = depth * 10 / screen;
+		FntPrint("%s%d.%d ", depth_name[i], depth / 10, depth % 10);
+	}
+	semi = semi * 10 / screen;
+	FntPrint("semi%d.%d\n", semi / 10, semi % 10);
+}
+#endif
+
 //Stage HUD functions
 static void Stage_DrawHealth(s16 health, u8 i, s8 ox)
 {
@@ -695,7 +895,7 @@ static void Stage_DrawHealth(s16 health, u8 i, s8 ox)
 	}
 	
 	//Draw health icon
-	Stage_DrawTex(&stage.tex_hud1, &src, &dst, FIXED_MUL(stage.bump, stage.sbump));
+	Stage_DrawTex(&stage.tex_hud1, &src, &dst, FIXED_MUL32(stage.bump, stage.sbump));
     }
 
 static void Stage_DrawStrum(u8 i, RECT *note_src, RECT_FIXED *note_dst)
@@ -736,50 +936,54 @@ static void Stage_DrawStrum(u8 i, RECT *note_src, RECT_FIXED *note_dst)
 	}
 }
 
+//Sustain run structure
+typedef struct
+{
+	fixed_t top, bottom; //Screen space
+	u16 end;             //Chart position the last merged piece lasts until
+} SustainRun;
+
+static void Stage_DrawSustainRun(u8 lane, const SustainRun *run)
+{
+	//Draw whole run as one stretched body quad
+	RECT note_src = {160, (lane & 0x3) << 5, 32, 16};
+	RECT_FIXED note_dst = {
+		stage.note_x[lane] - FIXED_DEC(16,1),
+		run->top,
+		note_src.w << FIXED_SHIFT,
+		run->bottom - run->top
+	};
+	
+	if (stage.downscroll)
+		note_dst.y = -note_dst.y - note_dst.h;
+	Stage_DrawTex(&stage.tex_hud0, &note_src, &note_dst, stage.bump);
+}
+
 static void Stage_DrawNotes(void)
 {
 	//Check if opponent should draw as bot
 	u8 bot = (stage.mode >= StageMode_2P) ? 0 : NOTE_FLAG_OPPONENT;
 	
-	//Initialize scroll state
-	SectionScroll scroll;
-	scroll.start = stage.time_base;
+	//Get tallest sustain piece, anything further below the screen than this is hidden
+	fixed_t sustain_size = Fixed_Mul(stage.speed, stage.sustain_time * 150) + FIXED_UNIT;
 	
-	Section *scroll_section = stage.section_base;
-	Stage_GetSectionScroll(&scroll, scroll_section);
+	//Sustain bodies are merged per lane while they're contiguous
+	SustainRun sustain_run[8];
+	u8 sustain_runs = 0;
 	
-	//Push scroll back until cur_note is properly contained
-	while (scroll.start_step > stage.cur_note->pos)
-	{
-		//Look for previous section
-		Section *prev_section = Stage_GetPrevSection(scroll_section);
-		if (prev_section == NULL)
-			break;
-		
-		//Push scroll back
-		scroll_section = prev_section;
-		Stage_GetSectionScroll(&scroll, scroll_section);
-		scroll.start -= scroll.length;
-	}
+	//Sustain pieces are a step long, tracked per section as they're reached
+	Section *sus_section = stage.cur_section;
+	fixed_t sus_time = stage.step_time;
 	
 	//Draw notes
 	for (Note *note = stage.cur_note; note->pos != 0xFFFF; note++)
 	{
-		//Update scroll
-		while (note->pos >= scroll_section->end)
-		{
-			//Push scroll forward
-			scroll.start += scroll.length;
-			Stage_GetSectionScroll(&scroll, ++scroll_section);
-		}
-		
 		//Get note information
 		u8 i = ((note->type ^ stage.note_swap) & NOTE_FLAG_OPPONENT) != 0;
 		PlayerState *this = &stage.player_state[i];
 		
 		fixed_t note_fp = (fixed_t)note->pos << FIXED_SHIFT;
-		fixed_t time = (scroll.start - stage.song_time) + (scroll.length * (note->pos - scroll.start_step) / scroll.length_step);
-		fixed_t y = stage.note_y[(note->type & 0x7)] + FIXED_MUL(stage.speed, time * 150);
+		fixed_t y = stage.note_y[(note->type & 0x7)] + Fixed_Mul(stage.speed, (note->time - stage.song_time) * 150);
 		
 		//Check if went above screen
 		if (y < FIXED_DEC(-16 - SCREEN_HEIGHT2, 1))
@@ -805,15 +1009,23 @@ static void Stage_DrawNotes(void)
 			//Don't draw if below screen
 			RECT note_src;
 			RECT_FIXED note_dst;
-			if (y > (FIXED_DEC(SCREEN_HEIGHT,2) + scroll.size) || note->pos == 0xFFFF)
+			if (y > (FIXED_DEC(SCREEN_HEIGHT,2) + sustain_size) || note->pos == 0xFFFF)
 				break;
 			
 			//Draw note
 			if (note->type & NOTE_FLAG_SUSTAIN)
 			{
+				//Get the piece's section
+				while (note->pos >= sus_section->end)
+				{
+					sus_section++;
+					sus_time = FIXED_DIV(FIXED_DEC(12,1), ((fixed_t)(sus_section->flag & SECTION_FLAG_BPM_MASK) << FIXED_SHIFT) * 8 / 240);
+				}
+				
 				//Check for sustain clipping
 				fixed_t clip;
-				y -= scroll.size;
+				fixed_t size = Fixed_Mul(stage.speed, sus_time * 150) + FIXED_UNIT;
+				y -= size;
 				if (((note->type ^ stage.note_swap) & (bot | NOTE_FLAG_HIT)) || ((this->pad_held & note_key[note->type & 0x3]) && (note_fp + stage.late_sus_safe >= stage.note_scroll)))
 				{
 					 clip = stage.note_y[(note->type & 0x7)] - y;
@@ -851,25 +1063,27 @@ static void Stage_DrawNotes(void)
 				else
 				{
 					//Get note height
-					fixed_t next_time = (scroll.start - stage.song_time) + (scroll.length * (note->pos + 12 - scroll.start_step) / scroll.length_step);
-					fixed_t next_y = stage.note_y[(note->type & 0x7)] + FIXED_MUL(stage.speed, next_time * 150) - scroll.size;
+					fixed_t next_y = stage.note_y[(note->type & 0x7)] + Fixed_Mul(stage.speed, (note->time + sus_time - stage.song_time) * 150) - size;
 					fixed_t next_size = next_y - y;
 					
 					if (clip < next_size)
 					{
-						note_src.x = 160;
-						note_src.y = ((note->type & 0x3) << 5);
-						note_src.w = 32;
-						note_src.h = 16;
-						
-						note_dst.x = stage.note_x[note->type & 0x7] - FIXED_DEC(16,1);
-						note_dst.y = y + clip;
-						note_dst.w = note_src.w << FIXED_SHIFT;
-						note_dst.h = (next_y - y) - clip;
-						
-						if (stage.downscroll)
-							note_dst.y = -note_dst.y - note_dst.h;
-						Stage_DrawTex(&stage.tex_hud0, &note_src, &note_dst, stage.bump);
+						//Extend lane's run if this piece follows on from it, otherwise start a new one
+						u8 lane = note->type & 0x7;
+						SustainRun *run = &sustain_run[lane];
+						if ((sustain_runs & (1 << lane)) && run->end == note->pos)
+						{
+							run->bottom = next_y;
+						}
+						else
+						{
+							if (sustain_runs & (1 << lane))
+								Stage_DrawSustainRun(lane, run);
+							run->top = y + clip;
+							run->bottom = next_y;
+							sustain_runs |= 1 << lane;
+						}
+						run->end = note->pos + 12;
 					}
 				}
 			}
@@ -935,24 +1149,77 @@ static void Stage_DrawNotes(void)
 			}
 		}
 	}
+	
+	//Draw remaining sustain runs
+	for (u8 lane = 0; lane < 8; lane++)
+		if (sustain_runs & (1 << lane))
+			Stage_DrawSustainRun(lane, &sustain_run[lane]);
 }
 
 //Stage loads
+static void Stage_ExpandChart(IO_Data data)
+{
+	//Read header
+	const u8 *chart_byte = (const u8*)data;
+	u16 num_sections = ((u16*)data)[2];
+	u16 num_heads = ((u16*)data)[3];
+	u16 num_notes = ((u16*)data)[4];
+	
+	stage.speed = *((fixed_t*)data);
+	
+	//Allocate expanded sections and notes
+	size_t sections_size = num_sections * sizeof(Section);
+	stage.chart_data = Mem_Alloc(sections_size + num_notes * sizeof(Note));
+	if (stage.chart_data == NULL)
+	{
+		sprintf(error_msg, "[Stage_ExpandChart] Failed to allocate chart (%d notes)", num_notes);
+		ErrorLock();
+		return;
+	}
+	stage.sections = (Section*)stage.chart_data;
+	stage.notes = (Note*)((u8*)stage.chart_data + sections_size);
+	
+	memcpy(stage.sections, chart_byte + 10, sections_size);
+	
+	//Expand note heads
+	Note *note = Chart_ExpandHeads(stage.notes, stage.notes + num_notes - 1, chart_byte + 10 + sections_size, num_heads);
+	
+	//Push dummy note
+	note->pos = 0xFFFF;
+	note->type = NOTE_FLAG_HIT;
+	note->time = 0x7FFFFFFF;
+	stage.num_notes = note - stage.notes;
+	
+	//Precompute note times, and the longest a sustain piece lasts
+	ChartTimer timer, end_timer;
+	ChartTimer_Init(&timer);
+	ChartTimer_Init(&end_timer);
+	
+	stage.sustain_time = 0;
+	for (note = stage.notes; note->pos != 0xFFFF; note++)
+	{
+		note->time = ChartTimer_GetTime(&timer, note->pos);
+		if (note->type & NOTE_FLAG_SUSTAIN)
+		{
+			fixed_t sustain_time = ChartTimer_GetTime(&end_timer, note->pos + 12) - note->time;
+			if (sustain_time > stage.sustain_time)
+				stage.sustain_time = sustain_time;
+		}
+	}
+}
+
+static void Stage_RewindChart(void);
+
 static void Stage_LoadChart(void)
 {
 	//reset dialog
 	stage.dialog = false;
 	
-	//Get chart data
-	stage.chart_data = stageoverlay_getchart();
-	u8 *chart_byte = (u8*)stage.chart_data;
-	
-	//Directly use section and notes pointers
-	stage.sections = (Section*)(chart_byte + 6);
-	stage.notes = (Note*)(chart_byte + ((u16*)stage.chart_data)[2]);
-	
-	for (Note *note = stage.notes; note->pos != 0xFFFF; note++)
-		stage.num_notes++;
+	//Read chart from the overlay data and expand it
+	Mem_Free(stage.chart_data);
+	IO_Data chart = stageoverlay_getchart();
+	Stage_ExpandChart(chart);
+	Mem_Free(chart);
 	
 	//Count max scores
 	stage.player_state[0].max_score = 0;
@@ -971,15 +1238,18 @@ static void Stage_LoadChart(void)
 	else
 		stage.max_score = stage.player_state[0].max_score;
 	
+	Stage_RewindChart();
+}
+
+static void Stage_RewindChart(void)
+{
+	//Start from the first section and note
 	stage.cur_section = stage.sections;
 	stage.cur_note = stage.notes;
 	
-	stage.speed = *((fixed_t*)stage.chart_data);
-	
 	stage.step_crochet = 0;
 	stage.time_base = 0;
 	stage.step_base = 0;
-	stage.section_base = stage.cur_section;
 	Stage_ChangeBPM(stage.cur_section->flag & SECTION_FLAG_BPM_MASK, 0);
 }
 static void Stage_LoadSFX(void)
@@ -1030,7 +1300,17 @@ static void Stage_LoadSFX(void)
 	}
 
 	for (int i = 0; i < 4; i++)
-	printf("address = %08x\n", Stage_Sounds[i]);
+		LOG_TRACE(LOG_STAGE, "Stage sound %d at %08x", i, Stage_Sounds[i]);
+}
+
+static u8 Stage_GetStreamChunks(const char *overlay_path)
+{
+	//Story mode moves between an overlay's stages without Stage_Load, so they all share the deepest ring any of them wants
+	u8 chunks = 0;
+	for (StageId id = 0; id < StageId_Max; id++)
+		if (stage_defs[id].stream_chunks > chunks && strcmp(stage_defs[id].overlay_path, overlay_path) == 0)
+			chunks = stage_defs[id].stream_chunks;
+	return chunks;
 }
 
 static void Stage_LoadMusic(void)
@@ -1041,15 +1321,17 @@ static void Stage_LoadMusic(void)
 	if (stage.gf != NULL)
 		stage.gf->sing_end -= stage.note_scroll;
 
+	//Prefetch the song that most likely follows in story mode, a wrong guess only costs the lookup
+	StageId next_id = stage.stage_id + 1;
+	if (stage.story && next_id < StageId_Max && strcmp(stage_defs[next_id].overlay_path, stage.stage_def->overlay_path) == 0)
+		Audio_PrefetchMus(stage_defs[next_id].mus_path);
+	
 	//Begin reading mus
 	Audio_LoadMus(stage.stage_def->mus_path);
 	
 	//Initialize music state
 	stage.note_scroll = FIXED_DEC(-5 * 4 * 12,1);
 	stage.song_time = FIXED_DIV(stage.note_scroll, stage.step_crochet);
-	stage.interp_time = 0;
-	stage.interp_ms = 0;
-	stage.interp_speed = 0;
 	
 	//Offset sing ends again
 	stage.player->sing_end += stage.note_scroll;
@@ -1090,26 +1372,22 @@ static void Stage_LoadState(void)
 		
 		stage.player_state[i].refresh_score = false;
 		stage.player_state[i].score = 0;
-		stage.player_state[i].score_text[0] = '0';
-		stage.player_state[i].score_text[1] = '\0';
+		Stage_SetDigits(&stage.player_state[i].score_digits, 0, false);
 
 		stage.player_state[i].refresh_miss = false;
 		stage.player_state[i].miss = 0;
+		Stage_SetDigits(&stage.player_state[i].miss_digits, 0, false);
 
+		stage.player_state[i].refresh_accuracy = false;
 		stage.player_state[i].accuracy = 0;
 		stage.player_state[i].max_accuracy = 0;
 		stage.player_state[i].min_accuracy = 0;
-
-		stage.player_state[i].accuracy_text[0] = '0';
-		stage.player_state[i].accuracy_text[1] = '\0';
-
-		stage.player_state[i].miss_text[0] = '0';
-		stage.player_state[i].miss_text[1] = '\0';
+		Stage_SetDigits(&stage.player_state[i].accuracy_digits, 0, false);
 		
 		stage.player_state[i].pad_held = stage.player_state[i].pad_press = 0;
 	}
 	
-	ObjectList_Free(&stage.objlist_splash);
+	Particle_Clear(&stage.splashes);
 	ObjectList_Free(&stage.objlist_fg);
 	ObjectList_Free(&stage.objlist_bg);
 }
@@ -1153,6 +1431,56 @@ static void Stage_InitCamera(void)
 	stage.hbump = FIXED_UNIT;
 }
 
+static void Stage_FreeSnapshot(void)
+{
+	//Free character snapshots
+	Mem_Free(stage.gf_snap);
+	stage.gf_snap = NULL;
+	Mem_Free(stage.opponent_snap);
+	stage.opponent_snap = NULL;
+	Mem_Free(stage.player_snap);
+	stage.player_snap = NULL;
+}
+
+static void Stage_TakeSnapshot(void)
+{
+	//Remember the characters as they are before the song starts
+	Stage_FreeSnapshot();
+	stage.player_snap = Character_Snapshot(stage.player);
+	stage.opponent_snap = Character_Snapshot(stage.opponent);
+	stage.gf_snap = Character_Snapshot(stage.gf);
+}
+
+static boolean Stage_Retry(void)
+{
+	//Check if everything the death sequence touched can be put back
+	if (stage.player_snap == NULL || stage.opponent_snap == NULL || (stage.gf != NULL && stage.gf_snap == NULL))
+		return false;
+	if (!Gfx_BackupRestore())
+		return false;
+	
+	//Restore characters, nobody is mid-note at the start of the song
+	Character_Restore(stage.player, stage.player_snap);
+	Character_Restore(stage.opponent, stage.opponent_snap);
+	Character_Restore(stage.gf, stage.gf_snap);
+	stage.player->sing_end = stage.opponent->sing_end = 0;
+	if (stage.gf != NULL)
+		stage.gf->sing_end = 0;
+	
+	//Rewind chart
+	for (Note *note = stage.notes; note->pos != 0xFFFF; note++)
+		note->type &= ~NOTE_FLAG_HIT;
+	Stage_RewindChart();
+	
+	//Restart song, only the music has to be read again
+	Stage_LoadState();
+	Stage_InitCamera();
+	stage.note_scroll = 0;
+	Stage_LoadMusic();
+	Timer_Reset();
+	return true;
+}
+
 //Stage functions
 void Stage_Load(StageId id, StageDiff difficulty, boolean story)
 {
@@ -1161,9 +1489,15 @@ void Stage_Load(StageId id, StageDiff difficulty, boolean story)
 	stage.stage_diff = difficulty;
 	stage.story = story;
 	
-	//Load overlay
+	//Load overlay, dropping resident data it doesn't use to give its heap the space
+	Resident_Load(stage.stage_def->residents);
 	Overlay_Load(stage.stage_def->overlay_path);
 	stage.stage_def->overlay_setptr();
+	stage.chart_data = NULL; //Heap was reset by the overlay load
+	
+	//Set up mus streaming before the overlay allocates any sounds
+	Audio_SetStreamChunks(Stage_GetStreamChunks(stage.stage_def->overlay_path));
+	stage.player_snap = stage.opponent_snap = stage.gf_snap = NULL;
 
 	//Load HUD textures
 	//circle notes week 6
@@ -1192,6 +1526,7 @@ void Stage_Load(StageId id, StageDiff difficulty, boolean story)
 	
 	//Initialize camera
 	Stage_InitCamera();
+	Stage_TakeSnapshot();
     
 	//Initialize notes
 	Note_Init();
@@ -1222,8 +1557,12 @@ void Stage_LoadScr(StageId id, StageDiff difficulty, boolean story)
 
 void Stage_Unload(void)
 {
+	//Free retry state
+	Gfx_BackupEnd();
+	Stage_FreeSnapshot();
+	
 	//Free objects
-	ObjectList_Free(&stage.objlist_splash);
+	Particle_Clear(&stage.splashes);
 	ObjectList_Free(&stage.objlist_fg);
 	ObjectList_Free(&stage.objlist_bg);
 	
@@ -1235,6 +1574,10 @@ void Stage_Unload(void)
 	Character_Free(stage.gf);
 	stage.gf = NULL;
 	
+	//Free chart
+	Mem_Free(stage.chart_data);
+	stage.chart_data = NULL;
+	
 	//Free stage
 	if (stageoverlay_free != NULL)
 		stageoverlay_free();
@@ -1244,13 +1587,13 @@ void Stage_Unload(void)
 static void Stage_PlayIntro(void)
 {
 	if (stage.song_step == -20)
-    Audio_PlaySound(Stage_Sounds[0]);
+    Audio_PlaySoundEx(Stage_Sounds[0], AUDIO_PRIORITY_HIGH, 0x3FFF, 0x1000);
 	if (stage.song_step == -15)
-	Audio_PlaySound(Stage_Sounds[1]);
+	Audio_PlaySoundEx(Stage_Sounds[1], AUDIO_PRIORITY_HIGH, 0x3FFF, 0x1000);
 	if (stage.song_step == -10)
-	Audio_PlaySound(Stage_Sounds[2]);
+	Audio_PlaySoundEx(Stage_Sounds[2], AUDIO_PRIORITY_HIGH, 0x3FFF, 0x1000);
 	if (stage.song_step == -5)
-	Audio_PlaySound(Stage_Sounds[3]);
+	Audio_PlaySoundEx(Stage_Sounds[3], AUDIO_PRIORITY_HIGH, 0x3FFF, 0x1000);
 
     //intro week 6
 	if (stage.stage_id >= StageId_6_1 && stage.stage_id <= StageId_6_3)
@@ -1306,6 +1649,11 @@ void Stage_Tick(void)
 {
 	SeamLoad:;
 	
+	//Reload GTE state before this frame's first transform
+	#ifndef PSXF_PC
+		stage_gte_zoom = 0;
+	#endif
+	
 	//Tick transition
 		//Return to menu when start is pressed
 		if (stage.state != StageState_Dialog)
@@ -1315,6 +1663,7 @@ void Stage_Tick(void)
 			Trans_Start();
 		}
 	
+	Gfx_SetFillLayer(StageLayer_Trans);
 	if (Trans_Tick())
 	{
 		switch (stage.trans)
@@ -1332,6 +1681,7 @@ void Stage_Tick(void)
 					Stage_LoadChart();
 					Stage_LoadState();
 					Stage_InitCamera();
+					Stage_TakeSnapshot();
 					Stage_LoadMusic();
 					Timer_Reset();
 					}
@@ -1359,6 +1709,10 @@ void Stage_Tick(void)
 				gameloop = GameLoop_Menu;
 				return;
 			case StageTrans_Reload:
+				//Retry in-place if possible
+				if (Stage_Retry())
+					break;
+				
 				//Reload song
 				Stage_Unload();
 				
@@ -1368,6 +1722,7 @@ void Stage_Tick(void)
 				break;
 		}
 	}
+	Gfx_SetFillLayer(StageLayer_Other);
 	
 	switch (stage.state)
 	{
@@ -1413,6 +1768,7 @@ void Stage_Tick(void)
 		}
 		case StageState_Play:
 		{
+			Profiler_Begin(ProfScope_Logic);
 			 Stage_PlayIntro();
 			//Clear per-frame flags
 			stage.flag &= ~(STAGE_FLAG_JUST_STEP | STAGE_FLAG_SCORE_REFRESH);
@@ -1422,29 +1778,21 @@ void Stage_Tick(void)
 
 			if (stage.movimentcamera)
 			{
-			if (stage.cur_section->flag & SECTION_FLAG_OPPFOCUS)
-			{
-				if ((stage.opponent->animatable.anim == CharAnim_Up) || (stage.opponent->animatable.anim == CharAnim_UpAlt))
-					stage.camera.y -= FIXED_DEC(2,10);
-				if ((stage.opponent->animatable.anim == CharAnim_Down) || (stage.opponent->animatable.anim == CharAnim_DownAlt))
-					stage.camera.y += FIXED_DEC(2,10);
-				if ((stage.opponent->animatable.anim == CharAnim_Left) || (stage.opponent->animatable.anim == CharAnim_LeftAlt))
-					stage.camera.x -= FIXED_DEC(2,10);
-				if ((stage.opponent->animatable.anim == CharAnim_Right) || (stage.opponent->animatable.anim == CharAnim_RightAlt))
-					stage.camera.x += FIXED_DEC(2,10);
-			}
-			else
-			{
-				if ((stage.player->animatable.anim == CharAnim_Up) || (stage.player->animatable.anim == CharAnim_UpAlt))
-					stage.camera.y -= FIXED_DEC(2,10);
-				if ((stage.player->animatable.anim == CharAnim_Down) || (stage.player->animatable.anim == CharAnim_DownAlt))
-					stage.camera.y += FIXED_DEC(2,10);
-				if ((stage.player->animatable.anim == CharAnim_Left) || (stage.player->animatable.anim == CharAnim_LeftAlt))
-					stage.camera.x -= FIXED_DEC(2,10);
-				if ((stage.player->animatable.anim == CharAnim_Right) || (stage.player->animatable.anim == CharAnim_RightAlt))
-					stage.camera.x += FIXED_DEC(2,10);
+				//Nudge the camera towards the lane the focused character is singing
+				static const s8 lane_move[4][2] = {
+					{-1,  0}, //Left
+					{ 0,  1}, //Down
+					{ 0, -1}, //Up
+					{ 1,  0}, //Right
+				};
+				Character *focus = (stage.cur_section->flag & SECTION_FLAG_OPPFOCUS) ? stage.opponent : stage.player;
+				CharAnimAttr attr = Character_AnimAttr(focus);
+				if (attr & CHAR_ANIM_SING)
+				{
+					stage.camera.x += lane_move[attr & CHAR_ANIM_LANE][0] * FIXED_DEC(2,10);
+					stage.camera.y += lane_move[attr & CHAR_ANIM_LANE][1] * FIXED_DEC(2,10);
+				}
 			}
-		}
 			
 			//Get song position
 			boolean playing;
@@ -1466,9 +1814,7 @@ void Stage_Tick(void)
 						Audio_SetVolume(1, 0x0000, 0x3FFF);
 						
 						//Update song time
-						stage.interp_ms = Audio_GetTime();
-						stage.interp_time = 0;
-						stage.song_time = stage.interp_ms;
+						stage.song_time = Audio_GetTime();
 					}
 					else
 					{
@@ -1483,9 +1829,7 @@ void Stage_Tick(void)
 				else if (Audio_IsPlaying())
 				{
 					//Sync to audio
-					stage.interp_ms = Audio_GetTime();
-					stage.interp_time = 0;
-					stage.song_time = stage.interp_ms;
+					stage.song_time = Audio_GetTime();
 					
 					playing = true;
 					
@@ -1562,7 +1906,6 @@ void Stage_Tick(void)
 					//Update BPM
 					u16 next_bpm = stage.cur_section->flag & SECTION_FLAG_BPM_MASK;
 					Stage_ChangeBPM(next_bpm, end);
-					stage.section_base = stage.cur_section;
 					
 					//Recalculate scroll based off new BPM
 					next_scroll = ((fixed_t)stage.step_base << FIXED_SHIFT) + FIXED_MUL(stage.song_time - stage.time_base, stage.step_crochet);
@@ -1660,19 +2003,22 @@ void Stage_Tick(void)
 					break;
 				}
 			}
+			Profiler_End(ProfScope_Logic);
 			
 			//Draw score
+			Profiler_Begin(ProfScope_HUD);
+			Gfx_SetFillLayer(StageLayer_HUD);
 			for (int i = 0; i < ((stage.mode >= StageMode_2P) ? 2 : 1); i++)
 			{
 				PlayerState *this = &stage.player_state[i];
 				
-				//Get string representing number
+				//Get digits representing number
 				if (this->refresh_score)
 				{
 					if (this->score != 0)
-						sprintf(this->score_text, "%d0", this->score * stage.max_score / this->max_score);
+						Stage_SetDigits(&this->score_digits, this->score * stage.max_score / this->max_score, true);
 					else
-						strcpy(this->score_text, "0");
+						Stage_SetDigits(&this->score_digits, 0, false);
 					this->refresh_score = false;
 				}
 				
@@ -1682,7 +2028,7 @@ void Stage_Tick(void)
 				if (stage.downscroll)
 					score_dst.y = FIXED_DEC(-87,1);
 				
-				Stage_DrawTex(&stage.tex_hud0, &score_src, &score_dst, FIXED_MUL(stage.bump, stage.hbump));
+				Stage_DrawTex(&stage.tex_hud0, &score_src, &score_dst, FIXED_MUL32(stage.bump, stage.hbump));
 				
 				//Draw number
 				score_src.y = 240;
@@ -1690,20 +2036,11 @@ void Stage_Tick(void)
 				score_dst.x += FIXED_DEC(40,1);
 				score_dst.w = FIXED_DEC(8,1);
 				
-				for (const char *p = this->score_text; ; p++)
+				for (u8 j = 0; j < this->score_digits.len; j++)
 				{
-					//Get character
-					char c = *p;
-					if (c == '\0')
-						break;
-					
 					//Draw character
-					if (c == '-')
-						score_src.x = 160;
-					else //Should be a number
-						score_src.x = 80 + ((c - '0') << 3);
-					
-					Stage_DrawTex(&stage.tex_hud0, &score_src, &score_dst, FIXED_MUL(stage.bump, stage.hbump));
+					score_src.x = this->score_digits.glyph[j];
+					Stage_DrawTex(&stage.tex_hud0, &score_src, &score_dst, FIXED_MUL32(stage.bump, stage.hbump));
 					
 					//Move character right
 					score_dst.x += FIXED_DEC(7,1);
@@ -1715,13 +2052,10 @@ void Stage_Tick(void)
 			{
 				PlayerState *this = &stage.player_state[i];
 				
-				//Get string representing number
+				//Get digits representing number
 				if (this->refresh_miss)
 				{
-					if (this->miss != 0)
-						sprintf(this->miss_text, "%d", this->miss);
-					else
-						strcpy(this->miss_text, "0");
+					Stage_SetDigits(&this->miss_digits, this->miss, false);
 					this->refresh_miss = false;
 				}
 				
@@ -1734,9 +2068,9 @@ void Stage_Tick(void)
 				RECT slash_src = {163, 224, 3, 13};
 				RECT_FIXED slash_dst = {FIXED_DEC(-64,1), miss_dst.y - FIXED_DEC(2,1), FIXED_DEC(3,1), FIXED_DEC(13,1)};
 				if (stage.mode != StageMode_2P)
-				Stage_DrawTex(&stage.tex_huds, &slash_src, &slash_dst, FIXED_MUL(stage.bump, stage.hbump));
+				Stage_DrawTex(&stage.tex_huds, &slash_src, &slash_dst, FIXED_MUL32(stage.bump, stage.hbump));
 				
-				Stage_DrawTex(&stage.tex_huds, &miss_src, &miss_dst, FIXED_MUL(stage.bump, stage.hbump));
+				Stage_DrawTex(&stage.tex_huds, &miss_src, &miss_dst, FIXED_MUL32(stage.bump, stage.hbump));
 				
 				//Draw number
 				miss_src.y = 240;
@@ -1744,17 +2078,11 @@ void Stage_Tick(void)
 				miss_dst.x += FIXED_DEC(40,1);
 				miss_dst.w = FIXED_DEC(8,1);
 				
-				for (const char *p = this->miss_text; ; p++)
+				for (u8 j = 0; j < this->miss_digits.len; j++)
 				{
-					//Get character
-					char c = *p;
-					if (c == '\0')
-						break;
-					
 					//Draw character
-					miss_src.x = 80 + ((c - '0') << 3);
-					
-					Stage_DrawTex(&stage.tex_huds, &miss_src, &miss_dst, FIXED_MUL(stage.bump, stage.hbump));
+					miss_src.x = this->miss_digits.glyph[j];
+					Stage_DrawTex(&stage.tex_huds, &miss_src, &miss_dst, FIXED_MUL32(stage.bump, stage.hbump));
 					
 					//Move character right
 					miss_dst.x += FIXED_DEC(7,1);
@@ -1766,15 +2094,14 @@ void Stage_Tick(void)
 			{
 				PlayerState *this = &stage.player_state[i];
 				
-				this->accuracy = (this->min_accuracy * 100) / (this->max_accuracy);
-				
-				//Get string representing number
+				//Get digits representing number, only dividing when accuracy has changed
 				if (this->refresh_accuracy)
 				{
-					if (this->accuracy != 0)
-						sprintf(this->accuracy_text, "%d", this->accuracy);
+					if (this->max_accuracy != 0)
+						this->accuracy = (this->min_accuracy * 100) / this->max_accuracy;
 					else
-						strcpy(this->accuracy_text, "0");
+						this->accuracy = 0;
+					Stage_SetDigits(&this->accuracy_digits, this->accuracy, false);
 					this->refresh_accuracy = false;
 				}
 				
@@ -1788,8 +2115,8 @@ void Stage_Tick(void)
 				RECT_FIXED slash_dst = {FIXED_DEC(10,1), accuracy_dst.y - FIXED_DEC(2,1), FIXED_DEC(3,1), FIXED_DEC(13,1)};
                 if (stage.mode != StageMode_2P)
 				{
-				Stage_DrawTex(&stage.tex_huds, &slash_src, &slash_dst, FIXED_MUL(stage.bump, stage.hbump));
-				Stage_DrawTex(&stage.tex_huds, &accuracy_src, &accuracy_dst, FIXED_MUL(stage.bump, stage.hbump));
+				Stage_DrawTex(&stage.tex_huds, &slash_src, &slash_dst, FIXED_MUL32(stage.bump, stage.hbump));
+				Stage_DrawTex(&stage.tex_huds, &accuracy_src, &accuracy_dst, FIXED_MUL32(stage.bump, stage.hbump));
 				}
 				
 				//Draw number
@@ -1798,21 +2125,12 @@ void Stage_Tick(void)
 				accuracy_dst.x += FIXED_DEC(56,1);
 				accuracy_dst.w = FIXED_DEC(8,1);
 				
-				for (const char *p = this->accuracy_text; ; p++)
+				for (u8 j = 0; j < this->accuracy_digits.len; j++)
 				{
-					//Get character
-					char c = *p;
-					if (c == '\0')
-						break;
-					
-				   //Draw character
-					if (c == '-')
-						accuracy_src.x = 160;
-					else //Should be a number
-						accuracy_src.x = 80 + ((c - '0') << 3);
-					
+					//Draw character
+					accuracy_src.x = this->accuracy_digits.glyph[j];
 					if (stage.mode != StageMode_2P)
-					Stage_DrawTex(&stage.tex_huds, &accuracy_src, &accuracy_dst, FIXED_MUL(stage.bump, stage.hbump));
+					Stage_DrawTex(&stage.tex_huds, &accuracy_src, &accuracy_dst, FIXED_MUL32(stage.bump, stage.hbump));
 					
 					//Move character right
 					accuracy_dst.x += FIXED_DEC(7,1);
@@ -1821,7 +2139,7 @@ void Stage_Tick(void)
 				RECT accur_src = {138, 223, 9, 11};
 				RECT_FIXED accur_dst = {accuracy_dst.x, accuracy_dst.y - FIXED_DEC(1,1), FIXED_DEC(9,1), FIXED_DEC(11,1)};
 				if (stage.mode != StageMode_2P)
-				Stage_DrawTex(&stage.tex_huds, &accur_src, &accur_dst, FIXED_MUL(stage.bump, stage.hbump));
+				Stage_DrawTex(&stage.tex_huds, &accur_src, &accur_dst, FIXED_MUL32(stage.bump, stage.hbump));
 
 				if (this->miss == 0)
 				{		
@@ -1829,7 +2147,7 @@ void Stage_Tick(void)
 				RECT fc_src = {149, 226, 13, 9};
 				RECT_FIXED fc_dst = {accuracy_dst.x + FIXED_DEC(16,1), accuracy_dst.y, FIXED_DEC(13,1), FIXED_DEC(9,1)};
                 if (stage.mode != StageMode_2P)
-				Stage_DrawTex(&stage.tex_huds, &fc_src, &fc_dst, FIXED_MUL(stage.bump, stage.hbump));
+				Stage_DrawTex(&stage.tex_huds, &fc_src, &fc_dst, FIXED_MUL32(stage.bump, stage.hbump));
 				}
 			}
 			
@@ -1895,11 +2213,15 @@ void Stage_Tick(void)
 				Stage_DrawTexCol(&stage.tex_huds, &health_back, &health_dst, stage.bump, barp_r >> 1, barp_g >> 1, barp_b >> 1);
 			}
 
+			Profiler_End(ProfScope_HUD);
+			
 			//Draw stage notes
+			Profiler_Begin(ProfScope_Notes);
+			Gfx_SetFillLayer(StageLayer_Notes);
 			Stage_DrawNotes();
 
 			//Tick note splashes
-			ObjectList_Tick(&stage.objlist_splash);
+			Particle_Tick(&stage.splashes);
 			
 			//Draw note HUD
 			RECT note_src = {0, 0, 32, 32};
@@ -1923,34 +2245,61 @@ void Stage_Tick(void)
 				Stage_DrawStrum(i | 4, &note_src, &note_dst);
 				Stage_DrawTex(&stage.tex_hud0, &note_src, &note_dst, stage.bump);
 			}
+			Profiler_End(ProfScope_Notes);
 
-			FntPrint("step: %d", stage.song_step);
+			#ifdef PSXF_DEBUG
+				FntPrint("step: %d", stage.song_step);
+				
+				Audio_StreamStats stream_stats;
+				Audio_GetStreamStats(&stream_stats);
+				FntPrint(" mus: %d/%d", stream_stats.underruns, stream_stats.late_refills);
+				FntPrint(" jitter: %dms", (Audio_GetTimeJitter() * 1000) >> FIXED_SHIFT);
+				Stage_PrintFill();
+			#endif
 			
 			//Tick foreground objects
+			Gfx_SetFillLayer(StageLayer_Objects);
 			ObjectList_Tick(&stage.objlist_fg);
 			
 			//Draw stage foreground
+			Profiler_Begin(ProfScope_BG);
+			Gfx_SetFillLayer(StageLayer_FG);
 			if (stageoverlay_drawfg != NULL)
 				stageoverlay_drawfg();
+			Profiler_End(ProfScope_BG);
 			
 			//Tick characters
+			Profiler_Begin(ProfScope_Chars);
+			Gfx_SetFillLayer(StageLayer_Chars);
 			stage.player->tick(stage.player);
 			stage.opponent->tick(stage.opponent);
+			Profiler_End(ProfScope_Chars);
 			
 			//Draw stage middle
+			Profiler_Begin(ProfScope_BG);
+			Gfx_SetFillLayer(StageLayer_MD);
 			if (stageoverlay_drawmd != NULL)
 				stageoverlay_drawmd();
+			Profiler_End(ProfScope_BG);
 			
 			//Tick girlfriend
+			Profiler_Begin(ProfScope_Chars);
+			Gfx_SetFillLayer(StageLayer_Chars);
 			if (stage.gf != NULL)
 				stage.gf->tick(stage.gf);
+			Profiler_End(ProfScope_Chars);
 			
 			//Tick background objects
+			Gfx_SetFillLayer(StageLayer_Objects);
 			ObjectList_Tick(&stage.objlist_bg);
 			
 			//Draw stage background
+			Profiler_Begin(ProfScope_BG);
+			Gfx_SetFillLayer(StageLayer_BG);
 			if (stageoverlay_drawbg != NULL)
 				stageoverlay_drawbg();
+			Profiler_End(ProfScope_BG);
+			Gfx_SetFillLayer(StageLayer_Other);
 			break;
 		}
 		case StageState_Dead: //Start BREAK animation
@@ -1967,20 +2316,13 @@ void Stage_Tick(void)
 			Audio_StopMus();
 	
 	        //Free objects
-	        ObjectList_Free(&stage.objlist_splash);
+	        Particle_Clear(&stage.splashes);
 	        ObjectList_Free(&stage.objlist_fg);
 	        ObjectList_Free(&stage.objlist_bg);
 			
-			//Free opponent and girlfriend
-			Character_Free(stage.opponent);
-			stage.opponent = NULL;
-			Character_Free(stage.gf);
-			stage.gf = NULL;
-
-			//Free stage
-	        if (stageoverlay_free != NULL)
-		    stageoverlay_free();
-	
+			//Keep the opponent, girlfriend and stage loaded for retrying,
+			//saving whatever the death sequence overwrites in VRAM
+			Gfx_BackupBegin();
 			
 			//Reset stage state
 			stage.flag = 0;
@@ -15,6 +15,7 @@
 #include "character.h"
 #include "player.h"
 #include "object.h"
+#include "object/particle.h"
 
 #include "network.h"
 
@@ -107,9 +108,11 @@ typedef struct
 	//Overlay
 	const char *overlay_path;
 	void (*overlay_setptr)(void);
+	u8 residents; //Resident data the overlay's characters use
 	
 	//Mus file
 	const char *mus_path;
+	u8 stream_chunks; //Mus stream ring depth, 0 for the default, the deepest of an overlay's stages is used for all of them
 
 	//Switch week.c in the next song
 	boolean swap;
@@ -126,7 +129,7 @@ typedef void (*StageOverlay_DrawMD)(void);
 typedef void (*StageOverlay_DrawFG)(void);
 typedef void (*StageOverlay_Dialog)(void);
 typedef void (*StageOverlay_Free)(void);
-typedef IO_Data (*StageOverlay_GetChart)(void);
+typedef IO_Data (*StageOverlay_GetChart)(void); //Returns a heap allocated chart, freed by the stage
 typedef boolean (*StageOverlay_LoadScreen)(void);
 typedef boolean (*StageOverlay_NextStage)(void);
 
@@ -163,8 +166,24 @@ typedef struct
 {
 	u16 pos; //1/12 steps
 	u16 type;
+	fixed_t time; //Song time the note is hit at, sustain pieces last a step of their section
 } Note;
 
+typedef struct
+{
+	RECT src;
+	POINT_FIXED p[4]; //Top left, top right, bottom left, bottom right
+} StageQuad;
+
+#define STAGE_BATCH_QUADS 16 //Quads transformed together by Stage_DrawQuadBatch
+#define STAGE_QUAD_OPAQUE 0xFF //Stage_DrawQuadBatch mode for no blending
+
+typedef struct
+{
+	u8 len;
+	u8 glyph[12]; //Source x of each digit in the HUD texture
+} StageDigits;
+
 typedef struct
 {
 	Character *character;
@@ -176,17 +195,17 @@ typedef struct
 	
 	boolean refresh_score;
 	s32 score, max_score;
-	char score_text[13];
+	StageDigits score_digits;
 
 	boolean refresh_miss;
 	s16 miss;
-	char miss_text[13];
+	StageDigits miss_digits;
 	
 	boolean refresh_accuracy;
 	s16 min_accuracy;
 	s16 accuracy;
 	s16 max_accuracy;
-	char accuracy_text[13];
+	StageDigits accuracy_digits;
 	
 	u16 pad_held, pad_press;
 } PlayerState;
@@ -212,6 +231,7 @@ typedef struct
 	Section *sections;
 	Note *notes;
 	size_t num_notes;
+	fixed_t sustain_time; //Longest sustain piece
 
 	fixed_t speed;
 	fixed_t step_crochet, step_time;
@@ -233,17 +253,17 @@ typedef struct
 	Character *player;
 	Character *opponent;
 	Character *gf;
+	Character *player_snap, *opponent_snap, *gf_snap; //Characters as they were after loading, for retrying
 	
 	Section *cur_section; //Current section
 	Note *cur_note; //First visible and hittable note, used for drawing and hit detection
 	
-	fixed_t note_scroll, song_time, interp_time, interp_ms, interp_speed;
+	fixed_t note_scroll, song_time;
 	
 	u16 last_bpm;
 	
 	fixed_t time_base;
 	u16 step_base;
-	Section *section_base;
 	
 	s16 song_step;
     
@@ -273,8 +293,11 @@ typedef struct
 	
 	u8 note_swap;
 	
+	//Note splashes
+	ParticleSystem splashes;
+	
 	//Object lists
-	ObjectList objlist_splash, objlist_fg, objlist_bg;
+	ObjectList objlist_fg, objlist_bg;
 } Stage;
 
 extern Stage stage;
@@ -282,6 +305,8 @@ extern Stage stage;
 //Stage drawing functions
 void Stage_DrawTexCol(Gfx_Tex *tex, const RECT *src, const RECT_FIXED *dst, fixed_t zoom, u8 r, u8 g, u8 b);
 void Stage_DrawTex(Gfx_Tex *tex, const RECT *src, const RECT_FIXED *dst, fixed_t zoom);
+void Stage_TransformPoints(const POINT_FIXED *in, POINT *out, size_t n, fixed_t zoom);
+void Stage_DrawQuadBatch(Gfx_Tex *tex, const StageQuad *quad, size_t quads, fixed_t zoom, u8 r, u8 g, u8 b, u8 mode);
 void Stage_DrawTexArbCol(Gfx_Tex *tex, const RECT *src, const POINT_FIXED *p0, const POINT_FIXED *p1, const POINT_FIXED *p2, const POINT_FIXED *p3, u8 r, u8 g, u8 b, fixed_t zoom);
 void Stage_DrawTexArb(Gfx_Tex *tex, const RECT *src, const POINT_FIXED *p0, const POINT_FIXED *p1, const POINT_FIXED *p2, const POINT_FIXED *p3, fixed_t zoom);
 void Stage_BlendTexArbCol(Gfx_Tex *tex, const RECT *src, const POINT_FIXED *p0, const POINT_FIXED *p1, const POINT_FIXED *p2, const POINT_FIXED *p3, fixed_t zoom, u8 r, u8 g, u8 b, u8 mode);
@@ -9,145 +9,168 @@
 static const StageDef stage_defs[StageId_Max] = {
 	//Week 1
 	{ //StageId_1_1 (Bopeebo)
-		"\\WEEK1\\WEEK1.EXE;1", Week1_SetPtr,
+		"\\WEEK1\\WEEK1.EXE;1", Week1_SetPtr, RESIDENT_ALL,
 		"\\WEEK1\\WEEK1_1.MUS;1",
 		0,
+		0,
 		0
 	},
 	{ //StageId_1_2 (Fresh)
-		"\\WEEK1\\WEEK1.EXE;1", Week1_SetPtr,
+		"\\WEEK1\\WEEK1.EXE;1", Week1_SetPtr, RESIDENT_ALL,
 		"\\WEEK1\\WEEK1_2.MUS;1",
 		0,
+		0,
 		0
 	},
 	{ //StageId_1_3 (Dadbattle)
-		"\\WEEK1\\WEEK1.EXE;1", Week1_SetPtr,
+		"\\WEEK1\\WEEK1.EXE;1", Week1_SetPtr, RESIDENT_ALL,
 		"\\WEEK1\\WEEK1_3.MUS;1",
 		0,
+		0,
 		0
 	},
 	{ //StageId_1_4 (Tutorial)
-		"\\WEEK1\\WEEK1.EXE;1", Week1_SetPtr,
+		"\\WEEK1\\WEEK1.EXE;1", Week1_SetPtr, RESIDENT_ALL,
 		"\\WEEK1\\WEEK1_4.MUS;1",
 		0,
+		0,
 		0
 	},
 	
 	{ //StageId_2_1 (Spookeez)
-		"\\WEEK2\\WEEK2.EXE;1", Week2_SetPtr,
+		"\\WEEK2\\WEEK2.EXE;1", Week2_SetPtr, RESIDENT_ALL,
 		"\\WEEK2\\WEEK2_1.MUS;1",
 		0,
+		0,
 		0
 	},
 	{ //StageId_2_2 (South)
-		"\\WEEK2\\WEEK2.EXE;1", Week2_SetPtr,
+		"\\WEEK2\\WEEK2.EXE;1", Week2_SetPtr, RESIDENT_ALL,
 		"\\WEEK2\\WEEK2_2.MUS;1",
 		0,
+		0,
 		0
 	},
 	{ //StageId_2_3 (Monster)
-		"\\WEEK2\\WEEK2.EXE;1", Week2_SetPtr,
+		"\\WEEK2\\WEEK2.EXE;1", Week2_SetPtr, RESIDENT_ALL,
 		"\\WEEK2\\WEEK2_3.MUS;1",
 		0,
+		0,
 		0
 	},
 	
 	{ //StageId_3_1 (Pico)
-		"\\WEEK3\\WEEK3.EXE;1", Week3_SetPtr,
+		"\\WEEK3\\WEEK3.EXE;1", Week3_SetPtr, RESIDENT_ALL,
 		"\\WEEK3\\WEEK3_1.MUS;1",
 		0,
+		0,
 	    0
 	},
 	{ //StageId_3_2 (Philly Nice)
-		"\\WEEK3\\WEEK3.EXE;1", Week3_SetPtr,
+		"\\WEEK3\\WEEK3.EXE;1", Week3_SetPtr, RESIDENT_ALL,
 		"\\WEEK3\\WEEK3_2.MUS;1",
 		0,
+		0,
 		0
 	},
 	{ //StageId_3_3 (Blammed)
-		"\\WEEK3\\WEEK3.EXE;1", Week3_SetPtr,
+		"\\WEEK3\\WEEK3.EXE;1", Week3_SetPtr, RESIDENT_ALL,
 		"\\WEEK3\\WEEK3_3.MUS;1",
 		0,
+		0,
 		0
 	},
 	
 	{ //StageId_4_1 (Satin Panties)
-		"\\WEEK4\\WEEK4.EXE;1", Week4_SetPtr,
+		"\\WEEK4\\WEEK4.EXE;1", Week4_SetPtr, RESIDENT_FLAG(Resident_GF),
 		"\\WEEK4\\WEEK4_1.MUS;1",
 		0,
+		0,
 		0
 	},
 	{ //StageId_4_2 (High)
-		"\\WEEK4\\WEEK4.EXE;1", Week4_SetPtr,
+		"\\WEEK4\\WEEK4.EXE;1", Week4_SetPtr, RESIDENT_FLAG(Resident_GF),
 		"\\WEEK4\\WEEK4_2.MUS;1",
 		0,
+		0,
 		0
 	},
 	{ //StageId_4_3 (MILF)
-		"\\WEEK4\\WEEK4.EXE;1", Week4_SetPtr,
+		"\\WEEK4\\WEEK4.EXE;1", Week4_SetPtr, RESIDENT_FLAG(Resident_GF),
 		"\\WEEK4\\WEEK4_3.MUS;1",
 		0,
+		0,
 		0
 	},
 	{ //StageId_4_4 (Test)
-		"\\WEEK1\\WEEK1.EXE;1", Week1_SetPtr,
+		"\\WEEK1\\WEEK1.EXE;1", Week1_SetPtr, RESIDENT_ALL,
 		"\\WEEK4\\WEEK4_4.MUS;1",
 		0,
+		0,
 		0
 	},
 	
 	{ //StageId_5_1 (Cocoa)
-		"\\WEEK5\\WEEK5.EXE;1", Week5_SetPtr,
+		"\\WEEK5\\WEEK5.EXE;1", Week5_SetPtr, 0,
 		"\\WEEK5\\WEEK5_1.MUS;1",
 		0,
+		0,
 		0
 	},
 	{ //StageId_5_2 (Eggnog)
-		"\\WEEK5\\WEEK5.EXE;1", Week5_SetPtr,
+		"\\WEEK5\\WEEK5.EXE;1", Week5_SetPtr, 0,
 		"\\WEEK5\\WEEK5_2.MUS;1",
 		0,
+		0,
 		0
 	},
 	{ //StageId_5_3 (Winter Horrorland)
-		"\\WEEK5\\WEEK5.EXE;1", Week5_SetPtr,
+		"\\WEEK5\\WEEK5.EXE;1", Week5_SetPtr, 0,
 		"\\WEEK5\\WEEK5_3.MUS;1",
 		0,
+		0,
 		0
 	},
 	
 	{ //StageId_6_1 (Senpai)
-		"\\WEEK6\\WEEK6.EXE;1", Week6_SetPtr,
+		"\\WEEK6\\WEEK6.EXE;1", Week6_SetPtr, 0,
 		"\\WEEK6\\WEEK6_1.MUS;1",
+		0,
 	    0,
 		0
 	},
 	{ //StageId_6_2 (Roses)
-		"\\WEEK6\\WEEK6.EXE;1", Week6_SetPtr,
+		"\\WEEK6\\WEEK6.EXE;1", Week6_SetPtr, 0,
 		"\\WEEK6\\WEEK6_2.MUS;1",
 		0,
+		0,
 		0
 	},
 	{ //StageId_6_3 (Thorns)
-		"\\WEEK6\\WEEK6.EXE;1", Week6_SetPtr,
+		"\\WEEK6\\WEEK6.EXE;1", Week6_SetPtr, 0,
 		"\\WEEK6\\WEEK6_3.MUS;1",
 		0,
+		0,
 		0
 	},
 	{ //StageId_7_1 (Ugh)
-		"\\WEEK7\\WEEK7.EXE;1", Week7_SetPtr,
+		"\\WEEK7\\WEEK7.EXE;1", Week7_SetPtr, RESIDENT_ALL,
 		"\\WEEK7\\WEEK7_1.MUS;1",
 		0,
+		0,
 		0
 	},
 	{ //StageId_7_2 (Guns)
-		"\\WEEK7\\WEEK7.EXE;1", Week7_SetPtr,
+		"\\WEEK7\\WEEK7.EXE;1", Week7_SetPtr, RESIDENT_ALL,
 		"\\WEEK7\\WEEK7_2.MUS;1",
 		0,
+		0,
 		0
 	},
 	{ //StageId_7_3 (Stress)
-		"\\WEEK7\\WEEK7.EXE;1", Week7_SetPtr,
+		"\\WEEK7\\WEEK7.EXE;1", Week7_SetPtr, RESIDENT_ALL,
 		"\\WEEK7\\WEEK7_3.MUS;1",
+		3,
 		0,
 		0
 	}
@@ -52,6 +52,7 @@
 // Original PsyQ sample code : /psyq/addons/cd/MOVIE
 // Video to STR conversion : https://github.com/ABelliqueux/nolibgs_hello_worlds/tree/main/hello_str
 #include "movie.h"
+#include "log.h"
 
 #define IS_RGB24	1	// 0:16-bit playback, 1:24-bit playback (recommended for quality)
 #define RING_SIZE	32	// Ring Buffer size (32 sectors seems good enough)
@@ -154,9 +155,7 @@ static void strDoPlayback(STRFILE *str) {
 	
 	// Get the CD location of the STR file to play
 	if (CdSearchFile(&file, str->FileName) == 0) {
-		#ifdef DEBUG
-		printf("ERROR: I cannot find video file %s\n", str->FileName);
-		#endif
+		LOG_ERROR(LOG_MOVIE, "[PlayStr] Cannot find video file %s", str->FileName);
 		SetDispMask(1);
 		return;
 	}
@@ -369,9 +368,7 @@ static void strSync(STRENV *strEnv) {
     while (strEnv->FrameDone == 0) {
         if (--cnt == 0) { // Timeout handler
             // If a timeout occurs, force switching buffers
-			#ifdef DEBUG
-			printf("ERROR: A frame cannot be played!\n");
-			#endif
+			LOG_WARN(LOG_MOVIE, "[PlayStr] Frame decode timed out");
             strEnv->FrameDone = 1;
             strEnv->RectID = strEnv->RectID? 0: 1;
             strEnv->slice.x = strEnv->rect[strEnv->RectID].x;
@@ -18,5 +18,7 @@ extern fixed_t timer_sec, timer_dt;
 void Timer_Init(void);
 void Timer_Tick(void);
 void Timer_Reset(void);
+u32 Timer_GetCount(void);
+fixed_t Timer_GetCountAge(u32 count);
 
 #endif
@@ -78,14 +78,9 @@ boolean Trans_Tick(void)
 				0,
 				SCREEN_HEIGHT - cover - TRANS_FADE_LEN,
 				SCREEN_WIDTH,
-				1
+				TRANS_FADE_LEN
 			};
-			for (int i = 0; i < TRANS_FADE_LEN; i++)
-			{
-				u8 col = 255 * i / TRANS_FADE_LEN;
-				Gfx_BlendRect(&trans_fade, col, col, col, 2);
-				trans_fade.y++;
-			}
+			Gfx_BlendGradientRect(&trans_fade, 0, 0, 0, 255, 255, 255, 2);
 			return false;
 		}
 		case TransState_Out:
@@ -115,16 +110,11 @@ boolean Trans_Tick(void)
 			
 			RECT trans_fade = {
 				0,
-				cover + TRANS_FADE_LEN,
+				cover,
 				SCREEN_WIDTH,
-				1
+				TRANS_FADE_LEN
 			};
-			for (int i = 0; i < TRANS_FADE_LEN; i++)
-			{
-				u8 col = 255 * i / TRANS_FADE_LEN;
-				trans_fade.y--;
-				Gfx_BlendRect(&trans_fade, col, col, col, 2);
-			}
+			Gfx_BlendGradientRect(&trans_fade, 255, 255, 255, 0, 0, 0, 2);
 			return result;
 		}
 	}
@@ -68,7 +68,6 @@ typedef struct
 	IO_Data arc_ptr[BFCar_ArcMain_Max];
 	
 	Gfx_Tex tex, tex_retry;
-	u8 frame, tex_id;
 	u8 retry_bump;
 	
 	SkullFragment skull[COUNT_OF(char_bfcar_skull)];
@@ -176,12 +175,12 @@ static void Char_BFCar_SetFrame(void *user, u8 frame)
 	Char_BFCar *this = (Char_BFCar*)user;
 	
 	//Check if this is a new frame
-	if (frame != this->frame)
+	if (frame != this->character.frame)
 	{
 		//Check if new art shall be loaded
-		const CharFrame *cframe = &char_bfcar_frame[this->frame = frame];
-		if (cframe->tex != this->tex_id)
-			Gfx_LoadTex(&this->tex, this->arc_ptr[this->tex_id = cframe->tex], 0);
+		const CharFrame *cframe = &char_bfcar_frame[this->character.frame = frame];
+		if (cframe->tex != this->character.tex_id)
+			Gfx_LoadTex(&this->tex, this->arc_ptr[this->character.tex_id = cframe->tex], 0);
 	}
 }
 
@@ -323,7 +322,7 @@ static void Char_BFCar_Tick(Character *character)
 	
 	//Animate and draw character
 	Animatable_Animate(&character->animatable, (void*)this, Char_BFCar_SetFrame);
-	Character_Draw(character, &this->tex, &char_bfcar_frame[this->frame]);
+	Character_Draw(character, &this->tex, &char_bfcar_frame[this->character.frame]);
 }
 
 static void Char_BFCar_SetAnim(Character *character, u8 anim)
@@ -372,7 +371,7 @@ static Character *Char_BFCar_New(fixed_t x, fixed_t y)
 	this->character.free = Char_BFCar_Free;
 	
 	Animatable_Init(&this->character.animatable, char_bfcar_anim);
-	Character_Init((Character*)this, x, y);
+	Character_Init((Character*)this, sizeof(*this), x, y);
 	
 	//Set character information
 	this->character.spec = CHAR_SPEC_MISSANIM;
@@ -417,7 +416,7 @@ static Character *Char_BFCar_New(fixed_t x, fixed_t y)
 		*arc_ptr++ = Archive_Find((IO_Data)char_bfcar_arc_main, *pathp);
 	
 	//Initialize render state
-	this->tex_id = this->frame = 0xFF;
+	this->character.tex_id = this->character.frame = 0xFF;
 
 	//Initialize player state
 	this->retry_bump = 0;
@@ -38,7 +38,6 @@ typedef struct
 	IO_Data arc_ptr[BFWeeb_ArcMain_Max];
 	
 	Gfx_Tex tex;
-	u8 frame, tex_id;
 	
 	u8 skull_scale;
 } Char_BFWeeb;
@@ -212,12 +211,12 @@ static void Char_BFWeeb_SetFrame(void *user, u8 frame)
 	Char_BFWeeb *this = (Char_BFWeeb*)user;
 	
 	//Check if this is a new frame
-	if (frame != this->frame)
+	if (frame != this->character.frame)
 	{
 		//Check if new art shall be loaded
-		const CharFrame *cframe = &char_bfweeb_frame[this->frame = frame];
-		if (cframe->tex != this->tex_id)
-			Gfx_LoadTex(&this->tex, this->arc_ptr[this->tex_id = cframe->tex], 0);
+		const CharFrame *cframe = &char_bfweeb_frame[this->character.frame = frame];
+		if (cframe->tex != this->character.tex_id)
+			Gfx_LoadTex(&this->tex, this->arc_ptr[this->character.tex_id = cframe->tex], 0);
 	}
 }
 
@@ -260,9 +259,9 @@ static void Char_BFWeeb_Tick(Character *character)
 	//Animate and draw character
 	Animatable_Animate(&character->animatable, (void*)this, Char_BFWeeb_SetFrame);
 	if (stage.stage_id == StageId_4_4)
-	BFWeeb_ReverseDraw(character, &this->tex, &char_bfweeb_frame[this->frame]);
+	BFWeeb_ReverseDraw(character, &this->tex, &char_bfweeb_frame[this->character.frame]);
 	else
-	Character_Draw(character, &this->tex, &char_bfweeb_frame[this->frame]);
+	Character_Draw(character, &this->tex, &char_bfweeb_frame[this->character.frame]);
 }
 
 static void Char_BFWeeb_SetAnim(Character *character, u8 anim)
@@ -308,7 +307,7 @@ static Character *Char_BFWeeb_New(fixed_t x, fixed_t y)
 	else
 	Animatable_Init(&this->character.animatable, char_bfweeb_anim);
 
-	Character_Init((Character*)this, x, y);
+	Character_Init((Character*)this, sizeof(*this), x, y);
 	//Set character information
 	this->character.spec = CHAR_SPEC_MISSANIM;
 	
@@ -335,7 +334,7 @@ static Character *Char_BFWeeb_New(fixed_t x, fixed_t y)
 		*arc_ptr++ = Archive_Find((IO_Data)char_bfweeb_arc_main, *pathp);
 	
 	//Initialize render state
-	this->tex_id = this->frame = 0xFF;
+	this->character.tex_id = this->character.frame = 0xFF;
 	
 	return (Character*)this;
 }
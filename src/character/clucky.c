@@ -34,7 +34,6 @@ typedef struct
 	IO_Data arc_ptr[Clucky_Arc_Max];
 	
 	Gfx_Tex tex;
-	u8 frame, tex_id;
 } Char_Clucky;
 
 //Clucky character definitions
@@ -75,12 +74,12 @@ void Char_Clucky_SetFrame(void *user, u8 frame)
 	Char_Clucky *this = (Char_Clucky*)user;
 	
 	//Check if this is a new frame
-	if (frame != this->frame)
+	if (frame != this->character.frame)
 	{
 		//Check if new art shall be loaded
-		const CharFrame *cframe = &char_clucky_frame[this->frame = frame];
-		if (cframe->tex != this->tex_id)
-			Gfx_LoadTex(&this->tex, this->arc_ptr[this->tex_id = cframe->tex], 0);
+		const CharFrame *cframe = &char_clucky_frame[this->character.frame = frame];
+		if (cframe->tex != this->character.tex_id)
+			Gfx_LoadTex(&this->tex, this->arc_ptr[this->character.tex_id = cframe->tex], 0);
 	}
 }
 
@@ -94,7 +93,7 @@ void Char_Clucky_Tick(Character *character)
 	
 	//Animate and draw
 	Animatable_Animate(&character->animatable, (void*)this, Char_Clucky_SetFrame);
-	Character_Draw(character, &this->tex, &char_clucky_frame[this->frame]);
+	Character_Draw(character, &this->tex, &char_clucky_frame[this->character.frame]);
 }
 
 void Char_Clucky_SetAnim(Character *character, u8 anim)
@@ -129,7 +128,7 @@ Character *Char_Clucky_New(fixed_t x, fixed_t y)
 	this->character.free = Char_Clucky_Free;
 	
 	Animatable_Init(&this->character.animatable, char_clucky_anim);
-	Character_Init((Character*)this, x, y);
+	Character_Init((Character*)this, sizeof(*this), x, y);
 	
 	//Set character information
 	this->character.spec = 0;
@@ -157,7 +156,7 @@ Character *Char_Clucky_New(fixed_t x, fixed_t y)
 		*arc_ptr++ = Archive_Find(this->arc_main, *pathp);
 	
 	//Initialize render state
-	this->tex_id = this->frame = 0xFF;
+	this->character.tex_id = this->character.frame = 0xFF;
 	
 	return (Character*)this;
 }
@@ -33,7 +33,6 @@ typedef struct
 	IO_Data arc_ptr[GFWeeb_Arc_Max];
 	
 	Gfx_Tex tex;
-	u8 frame, tex_id;
 } Char_GFWeeb;
 
 //GF character definitions
@@ -67,12 +66,12 @@ static void Char_GFWeeb_SetFrame(void *user, u8 frame)
 	Char_GFWeeb *this = (Char_GFWeeb*)user;
 	
 	//Check if this is a new frame
-	if (frame != this->frame)
+	if (frame != this->character.frame)
 	{
 		//Check if new art shall be loaded
-		const CharFrame *cframe = &char_gfweeb_frame[this->frame = frame];
-		if (cframe->tex != this->tex_id)
-			Gfx_LoadTex(&this->tex, this->arc_ptr[this->tex_id = cframe->tex], 0);
+		const CharFrame *cframe = &char_gfweeb_frame[this->character.frame = frame];
+		if (cframe->tex != this->character.tex_id)
+			Gfx_LoadTex(&this->tex, this->arc_ptr[this->character.tex_id = cframe->tex], 0);
 	}
 }
 
@@ -102,7 +101,7 @@ static void Char_GFWeeb_Tick(Character *character)
 	
 	//Animate and draw
 	Animatable_Animate(&character->animatable, (void*)this, Char_GFWeeb_SetFrame);
-	Character_DrawParallax(character, &this->tex, &char_gfweeb_frame[this->frame], parallax);
+	Character_DrawParallax(character, &this->tex, &char_gfweeb_frame[this->character.frame], parallax);
 }
 
 static void Char_GFWeeb_SetAnim(Character *character, u8 anim)
@@ -135,7 +134,7 @@ static Character *Char_GFWeeb_New(fixed_t x, fixed_t y)
 	this->character.free = Char_GFWeeb_Free;
 	
 	Animatable_Init(&this->character.animatable, char_gfweeb_anim);
-	Character_Init((Character*)this, x, y);
+	Character_Init((Character*)this, sizeof(*this), x, y);
 	
 	//Set character information
 	this->character.spec = 0;
@@ -157,7 +156,7 @@ static Character *Char_GFWeeb_New(fixed_t x, fixed_t y)
 		*arc_ptr++ = Archive_Find((IO_Data)char_gfweeb_arc_main, *pathp);
 	
 	//Initialize render state
-	this->tex_id = this->frame = 0xFF;
+	this->character.tex_id = this->character.frame = 0xFF;
 	
 	return (Character*)this;
 }
@@ -33,7 +33,6 @@ typedef struct
 	IO_Data arc_ptr[MenuGF_Arc_Max];
 	
 	Gfx_Tex tex;
-	u8 frame, tex_id;
 	
 	//Pico test
 	u16 *pico_p;
@@ -75,12 +74,12 @@ static void Char_MenuGF_SetFrame(void *user, u8 frame)
 	Char_MenuGF *this = (Char_MenuGF*)user;
 	
 	//Check if this is a new frame
-	if (frame != this->frame)
+	if (frame != this->character.frame)
 	{
 		//Check if new art shall be loaded
-		const CharFrame *cframe = &char_menugf_frame[this->frame = frame];
-		if (cframe->tex != this->tex_id)
-			Gfx_LoadTex(&this->tex, this->arc_ptr[this->tex_id = cframe->tex], 0);
+		const CharFrame *cframe = &char_menugf_frame[this->character.frame = frame];
+		if (cframe->tex != this->character.tex_id)
+			Gfx_LoadTex(&this->tex, this->arc_ptr[this->character.tex_id = cframe->tex], 0);
 	}
 }
 
@@ -107,7 +106,7 @@ static void Char_MenuGF_Tick(Character *character)
 	//Animate and draw
 	fixed_t parallax = Char_MenuGF_GetParallax(this);
 	Animatable_Animate(&character->animatable, (void*)this, Char_MenuGF_SetFrame);
-	Character_DrawParallax(character, &this->tex, &char_menugf_frame[this->frame], parallax);
+	Character_DrawParallax(character, &this->tex, &char_menugf_frame[this->character.frame], parallax);
 }
 
 static void Char_MenuGF_SetAnim(Character *character, u8 anim)
@@ -138,7 +137,7 @@ static Character *Char_MenuGF_New(fixed_t x, fixed_t y)
 	this->character.free = Char_MenuGF_Free;
 	
 	Animatable_Init(&this->character.animatable, char_menugf_anim);
-	Character_Init((Character*)this, x, y);
+	Character_Init((Character*)this, sizeof(*this), x, y);
 	
 	//Set character information
 	this->character.spec = 0;
@@ -161,7 +160,7 @@ static Character *Char_MenuGF_New(fixed_t x, fixed_t y)
 		*arc_ptr++ = Archive_Find((IO_Data)char_menugf_arc_main, *pathp);
 	
 	//Initialize render state
-	this->tex_id = this->frame = 0xFF;
+	this->character.tex_id = this->character.frame = 0xFF;
 	
 	return (Character*)this;
 }
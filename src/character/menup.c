@@ -35,7 +35,6 @@ typedef struct
 	IO_Data arc_ptr[BF_ArcMain_Max];
 	
 	Gfx_Tex tex, tex_retry;
-	u8 frame, tex_id;
 	u8 skull_scale;
 } Char_BF;
 
@@ -70,12 +69,12 @@ static void Char_BF_SetFrame(void *user, u8 frame)
 	Char_BF *this = (Char_BF*)user;
 	
 	//Check if this is a new frame
-	if (frame != this->frame)
+	if (frame != this->character.frame)
 	{
 		//Check if new art shall be loaded
-		const CharFrame *cframe = &char_menubf_frame[this->frame = frame];
-		if (cframe->tex != this->tex_id)
-			Gfx_LoadTex(&this->tex, this->arc_ptr[this->tex_id = cframe->tex], 0);
+		const CharFrame *cframe = &char_menubf_frame[this->character.frame = frame];
+		if (cframe->tex != this->character.tex_id)
+			Gfx_LoadTex(&this->tex, this->arc_ptr[this->character.tex_id = cframe->tex], 0);
 	}
 }
 
@@ -117,7 +116,7 @@ static void Char_BF_Tick(Character *character)
 	
 	//Animate and draw character
 	Animatable_Animate(&character->animatable, (void*)this, Char_BF_SetFrame);
-	Character_Draw(character, &this->tex, &char_menubf_frame[this->frame]);
+	Character_Draw(character, &this->tex, &char_menubf_frame[this->character.frame]);
 }
 
 static void Char_BF_SetAnim(Character *character, u8 anim)
@@ -149,7 +148,7 @@ static Character *Char_BF_New(fixed_t x, fixed_t y)
 	this->character.free = Char_BF_Free;
 	
 	Animatable_Init(&this->character.animatable, char_menubf_anim);
-	Character_Init((Character*)this, x, y);
+	Character_Init((Character*)this, sizeof(*this), x, y);
 	
 	//Set character information
 	this->character.spec = CHAR_SPEC_MISSANIM;
@@ -171,7 +170,7 @@ static Character *Char_BF_New(fixed_t x, fixed_t y)
 		*arc_ptr++ = Archive_Find((IO_Data)char_menubf_arc_main, *pathp);
 	
 	//Initialize render state
-	this->tex_id = this->frame = 0xFF;
+	this->character.tex_id = this->character.frame = 0xFF;
 	
 	return (Character*)this;
 }
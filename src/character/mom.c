@@ -42,7 +42,6 @@ typedef struct
 	IO_Data arc_ptr[Mom_Arc_Max];
 	
 	Gfx_Tex tex;
-	u8 frame, tex_id;
 	
 	//Hair texture
 	Gfx_Tex tex_hair;
@@ -86,12 +85,12 @@ static void Char_Mom_SetFrame(void *user, u8 frame)
 	Char_Mom *this = (Char_Mom*)user;
 	
 	//Check if this is a new frame
-	if (frame != this->frame)
+	if (frame != this->character.frame)
 	{
 		//Check if new art shall be loaded
-		const CharFrame *cframe = &char_mom_frame[this->frame = frame];
-		if (cframe->tex != this->tex_id)
-			Gfx_LoadTex(&this->tex, this->arc_ptr[this->tex_id = cframe->tex], 0);
+		const CharFrame *cframe = &char_mom_frame[this->character.frame = frame];
+		if (cframe->tex != this->character.tex_id)
+			Gfx_LoadTex(&this->tex, this->arc_ptr[this->character.tex_id = cframe->tex], 0);
 	}
 }
 
@@ -105,7 +104,7 @@ static void Char_Mom_Tick(Character *character)
 	
 	//Animate and draw
 	Animatable_Animate(&character->animatable, (void*)this, Char_Mom_SetFrame);
-	Character_Draw(character, &this->tex, &char_mom_frame[this->frame]);
+	Character_Draw(character, &this->tex, &char_mom_frame[this->character.frame]);
 	
 	//Draw hair
 	static const struct Char_Mom_HairDef
@@ -145,7 +144,7 @@ static void Char_Mom_Tick(Character *character)
 		{ 7, 10}
 	};
 	
-	const struct Char_Mom_HairDef *hair_def = &hair_defs[this->frame];
+	const struct Char_Mom_HairDef *hair_def = &hair_defs[this->character.frame];
 	u8 hair_i = (animf_count & 1) | hair_def->sy;
 	
 	const RECT *hair_src = &hair_srcs[hair_i];
@@ -188,7 +187,7 @@ static Character *Char_Mom_New(fixed_t x, fixed_t y)
 	this->character.free = Char_Mom_Free;
 	
 	Animatable_Init(&this->character.animatable, char_mom_anim);
-	Character_Init((Character*)this, x, y);
+	Character_Init((Character*)this, sizeof(*this), x, y);
 	
 	//Set character information
 	this->character.spec = 0;
@@ -218,7 +217,7 @@ static Character *Char_Mom_New(fixed_t x, fixed_t y)
 		*arc_ptr++ = Archive_Find((IO_Data)char_mom_arc_main, *pathp);
 	
 	//Initialize render state
-	this->tex_id = this->frame = 0xFF;
+	this->character.tex_id = this->character.frame = 0xFF;
 	
 	return (Character*)this;
 }
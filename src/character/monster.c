@@ -41,7 +41,6 @@ typedef struct
 	IO_Data arc_ptr[Monster_Arc_Max];
 	
 	Gfx_Tex tex;
-	u8 frame, tex_id;
 } Char_Monster;
 
 //Monster character definitions
@@ -84,12 +83,12 @@ static void Char_Monster_SetFrame(void *user, u8 frame)
 	Char_Monster *this = (Char_Monster*)user;
 	
 	//Check if this is a new frame
-	if (frame != this->frame)
+	if (frame != this->character.frame)
 	{
 		//Check if new art shall be loaded
-		const CharFrame *cframe = &char_monster_frame[this->frame = frame];
-		if (cframe->tex != this->tex_id)
-			Gfx_LoadTex(&this->tex, this->arc_ptr[this->tex_id = cframe->tex], 0);
+		const CharFrame *cframe = &char_monster_frame[this->character.frame = frame];
+		if (cframe->tex != this->character.tex_id)
+			Gfx_LoadTex(&this->tex, this->arc_ptr[this->character.tex_id = cframe->tex], 0);
 	}
 }
 
@@ -103,7 +102,7 @@ static void Char_Monster_Tick(Character *character)
 	
 	//Animate and draw
 	Animatable_Animate(&character->animatable, (void*)this, Char_Monster_SetFrame);
-	Character_Draw(character, &this->tex, &char_monster_frame[this->frame]);
+	Character_Draw(character, &this->tex, &char_monster_frame[this->character.frame]);
 }
 
 static void Char_Monster_SetAnim(Character *character, u8 anim)
@@ -135,7 +134,7 @@ static Character *Char_Monster_New(fixed_t x, fixed_t y)
 	this->character.free = Char_Monster_Free;
 	
 	Animatable_Init(&this->character.animatable, char_monster_anim);
-	Character_Init((Character*)this, x, y);
+	Character_Init((Character*)this, sizeof(*this), x, y);
 	
 	//Set character information
 	this->character.spec = 0;
@@ -163,7 +162,7 @@ static Character *Char_Monster_New(fixed_t x, fixed_t y)
 		*arc_ptr++ = Archive_Find((IO_Data)char_monster_arc_main, *pathp);
 	
 	//Initialize render state
-	this->tex_id = this->frame = 0xFF;
+	this->character.tex_id = this->character.frame = 0xFF;
 	
 	return (Character*)this;
 }
@@ -34,7 +34,6 @@ typedef struct
 	IO_Data arc_ptr[Spirit_Arc_Max];
 	
 	Gfx_Tex tex;
-	u8 frame, tex_id;
 	
 	//Distort state
 	fixed_t distort_ang, distort_pow, distort_spd;
@@ -83,12 +82,12 @@ static void Char_Spirit_SetFrame(void *user, u8 frame)
 	Char_Spirit *this = (Char_Spirit*)user;
 	
 	//Check if this is a new frame
-	if (frame != this->frame)
+	if (frame != this->character.frame)
 	{
 		//Check if new art shall be loaded
-		const CharFrame *cframe = &char_spirit_frame[this->frame = frame];
-		if (cframe->tex != this->tex_id)
-			Gfx_LoadTex(&this->tex, this->arc_ptr[this->tex_id = cframe->tex], 0);
+		const CharFrame *cframe = &char_spirit_frame[this->character.frame = frame];
+		if (cframe->tex != this->character.tex_id)
+			Gfx_LoadTex(&this->tex, this->arc_ptr[this->character.tex_id = cframe->tex], 0);
 	}
 	
 	//Process distortion
@@ -103,7 +102,7 @@ static void Char_Spirit_SetFrame(void *user, u8 frame)
 static void Char_Spirit_Draw(Char_Spirit *this, fixed_t x, fixed_t y, fixed_t phase, boolean mode)
 {
 	//Get character state stuff
-	const CharFrame *cframe = &char_spirit_frame[this->frame];
+	const CharFrame *cframe = &char_spirit_frame[this->character.frame];
 	
 	//Get offset coordinates
 	fixed_t ox = x - stage.camera.x - FIXED_DEC(cframe->off[0],1);
@@ -201,7 +200,7 @@ static Character *Char_Spirit_New(fixed_t x, fixed_t y)
 	this->character.free = Char_Spirit_Free;
 	
 	Animatable_Init(&this->character.animatable, char_spirit_anim);
-	Character_Init((Character*)this, x, y);
+	Character_Init((Character*)this, sizeof(*this), x, y);
 	
 	//Set character information
 	this->character.spec = 0;
@@ -224,7 +223,7 @@ static Character *Char_Spirit_New(fixed_t x, fixed_t y)
 		*arc_ptr++ = Archive_Find((IO_Data)char_spirit_arc_main, *pathp);
 	
 	//Initialize render state
-	this->tex_id = this->frame = 0xFF;
+	this->character.tex_id = this->character.frame = 0xFF;
 	
 	//Initialize distort speed
 	this->distort_ang = 0;
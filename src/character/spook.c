@@ -43,7 +43,6 @@ typedef struct
 	IO_Data arc_ptr[Spook_Arc_Max];
 	
 	Gfx_Tex tex;
-	u8 frame, tex_id;
 } Char_Spook;
 
 //Spook character definitions
@@ -102,12 +101,12 @@ static void Char_Spook_SetFrame(void *user, u8 frame)
 	Char_Spook *this = (Char_Spook*)user;
 	
 	//Check if this is a new frame
-	if (frame != this->frame)
+	if (frame != this->character.frame)
 	{
 		//Check if new art shall be loaded
-		const CharFrame *cframe = &char_spook_frame[this->frame = frame];
-		if (cframe->tex != this->tex_id)
-			Gfx_LoadTex(&this->tex, this->arc_ptr[this->tex_id = cframe->tex], 0);
+		const CharFrame *cframe = &char_spook_frame[this->character.frame = frame];
+		if (cframe->tex != this->character.tex_id)
+			Gfx_LoadTex(&this->tex, this->arc_ptr[this->character.tex_id = cframe->tex], 0);
 	}
 }
 
@@ -133,7 +132,7 @@ static void Char_Spook_Tick(Character *character)
 	}
 	//Animate and draw
 	Animatable_Animate(&character->animatable, (void*)this, Char_Spook_SetFrame);
-	Character_Draw(character, &this->tex, &char_spook_frame[this->frame]);
+	Character_Draw(character, &this->tex, &char_spook_frame[this->character.frame]);
 }
 
 static void Char_Spook_SetAnim(Character *character, u8 anim)
@@ -176,7 +175,7 @@ static Character *Char_Spook_New(fixed_t x, fixed_t y)
 	this->character.free = Char_Spook_Free;
 	
 	Animatable_Init(&this->character.animatable, char_spook_anim);
-	Character_Init((Character*)this, x, y);
+	Character_Init((Character*)this, sizeof(*this), x, y);
 	
 	//Set character information
 	this->character.spec = CHAR_SPEC_MISSANIM;
@@ -208,7 +207,7 @@ static Character *Char_Spook_New(fixed_t x, fixed_t y)
 		*arc_ptr++ = Archive_Find((IO_Data)char_spook_arc_main, *pathp);
 	
 	//Initialize render state
-	this->tex_id = this->frame = 0xFF;
+	this->character.tex_id = this->character.frame = 0xFF;
 	
 	return (Character*)this;
 }
@@ -44,7 +44,6 @@ typedef struct
 	IO_Data arc_ptr[Tank_Arc_Max];
 	
 	Gfx_Tex tex;
-	u8 frame, tex_id;
 	
 	//Mouth state
 	fixedu_t mouth_i;
@@ -103,12 +102,12 @@ static void Char_Tank_SetFrame(void *user, u8 frame)
 	Char_Tank *this = (Char_Tank*)user;
 	
 	//Check if this is a new frame
-	if (frame != this->frame)
+	if (frame != this->character.frame)
 	{
 		//Check if new art shall be loaded
-		const CharFrame *cframe = &char_tank_frame[this->frame = frame];
-		if (cframe->tex != this->tex_id)
-			Gfx_LoadTex(&this->tex, this->arc_ptr[this->tex_id = cframe->tex], 0);
+		const CharFrame *cframe = &char_tank_frame[this->character.frame = frame];
+		if (cframe->tex != this->character.tex_id)
+			Gfx_LoadTex(&this->tex, this->arc_ptr[this->character.tex_id = cframe->tex], 0);
 	}
 }
 
@@ -125,7 +124,7 @@ static void Char_Tank_Tick(Character *character)
 	Animatable_Animate(&character->animatable, (void*)this, Char_Tank_SetFrame);
 	
 	//Draw mouth if saying "...pretty good!"
-	if (this->frame == 22)
+	if (this->character.frame == 22)
 	{
 		//Mouth mappings
 		static const u8 mouth_map[] = {
@@ -158,7 +157,7 @@ static void Char_Tank_Tick(Character *character)
 	}
 	
 	//Draw body
-	Character_Draw(character, &this->tex, &char_tank_frame[this->frame]);
+	Character_Draw(character, &this->tex, &char_tank_frame[this->character.frame]);
 }
 
 static void Char_Tank_SetAnim(Character *character, u8 anim)
@@ -202,7 +201,7 @@ static Character *Char_Tank_New(fixed_t x, fixed_t y)
 	this->character.free = Char_Tank_Free;
 	
 	Animatable_Init(&this->character.animatable, char_tank_anim);
-	Character_Init((Character*)this, x, y);
+	Character_Init((Character*)this, sizeof(*this), x, y);
 	
 	//Set character information
 	this->character.spec = 0;
@@ -274,7 +273,7 @@ static Character *Char_Tank_New(fixed_t x, fixed_t y)
 	}
 	
 	//Initialize render state
-	this->tex_id = this->frame = 0xFF;
+	this->character.tex_id = this->character.frame = 0xFF;
 	
 	return (Character*)this;
 }
@@ -41,7 +41,6 @@ typedef struct
 	IO_Data arc_ptr[XmasGF_Arc_Max];
 	
 	Gfx_Tex tex;
-	u8 frame, tex_id;
 	
 	//Speaker
 	Speaker speaker;
@@ -91,12 +90,12 @@ static void Char_XmasGF_SetFrame(void *user, u8 frame)
 	Char_XmasGF *this = (Char_XmasGF*)user;
 	
 	//Check if this is a new frame
-	if (frame != this->frame)
+	if (frame != this->character.frame)
 	{
 		//Check if new art shall be loaded
-		const CharFrame *cframe = &char_xmasgf_frame[this->frame = frame];
-		if (cframe->tex != this->tex_id)
-			Gfx_LoadTex(&this->tex, this->arc_ptr[this->tex_id = cframe->tex], 0);
+		const CharFrame *cframe = &char_xmasgf_frame[this->character.frame = frame];
+		if (cframe->tex != this->character.tex_id)
+			Gfx_LoadTex(&this->tex, this->arc_ptr[this->character.tex_id = cframe->tex], 0);
 	}
 }
 
@@ -125,7 +124,7 @@ static void Char_XmasGF_Tick(Character *character)
 	//Animate and draw
 	fixed_t parallax = Char_XmasGF_GetParallax(this);
 	Animatable_Animate(&character->animatable, (void*)this, Char_XmasGF_SetFrame);
-	Character_DrawParallax(character, &this->tex, &char_xmasgf_frame[this->frame], parallax);
+	Character_DrawParallax(character, &this->tex, &char_xmasgf_frame[this->character.frame], parallax);
 	Speaker_Tick(&this->speaker, character->x, character->y, parallax);
 }
 
@@ -157,7 +156,7 @@ static Character *Char_XmasGF_New(fixed_t x, fixed_t y)
 	this->character.free = Char_XmasGF_Free;
 	
 	Animatable_Init(&this->character.animatable, char_xmasgf_anim);
-	Character_Init((Character*)this, x, y);
+	Character_Init((Character*)this, sizeof(*this), x, y);
 	
 	//Set character information
 	this->character.spec = 0;
@@ -180,7 +179,7 @@ static Character *Char_XmasGF_New(fixed_t x, fixed_t y)
 		*arc_ptr++ = Archive_Find((IO_Data)char_xmasgf_arc_main, *pathp);
 	
 	//Initialize render state
-	this->tex_id = this->frame = 0xFF;
+	this->character.tex_id = this->character.frame = 0xFF;
 	
 	//Initialize speaker
 	Speaker_Init(&this->speaker);
@@ -53,7 +53,6 @@ typedef struct
 	IO_Data arc_ptr[XmasP_Arc_Max];
 	
 	Gfx_Tex tex;
-	u8 frame, tex_id;
 } Char_XmasP;
 
 //Christmas Parents definitions
@@ -102,12 +101,12 @@ static void Char_XmasP_SetFrame(void *user, u8 frame)
 	Char_XmasP *this = (Char_XmasP*)user;
 	
 	//Check if this is a new frame
-	if (frame != this->frame)
+	if (frame != this->character.frame)
 	{
 		//Check if new art shall be loaded
-		const CharFrame *cframe = &char_xmasp_frame[this->frame = frame];
-		if (cframe->tex != this->tex_id)
-			Gfx_LoadTex(&this->tex, this->arc_ptr[this->tex_id = cframe->tex], 0);
+		const CharFrame *cframe = &char_xmasp_frame[this->character.frame = frame];
+		if (cframe->tex != this->character.tex_id)
+			Gfx_LoadTex(&this->tex, this->arc_ptr[this->character.tex_id = cframe->tex], 0);
 	}
 }
 
@@ -121,7 +120,7 @@ static void Char_XmasP_Tick(Character *character)
 	
 	//Animate and draw
 	Animatable_Animate(&character->animatable, (void*)this, Char_XmasP_SetFrame);
-	Character_Draw(character, &this->tex, &char_xmasp_frame[this->frame]);
+	Character_Draw(character, &this->tex, &char_xmasp_frame[this->character.frame]);
 }
 
 static void Char_XmasP_SetAnim(Character *character, u8 anim)
@@ -156,7 +155,7 @@ static Character *Char_XmasP_New(fixed_t x, fixed_t y)
 	this->character.free = Char_XmasP_Free;
 	
 	Animatable_Init(&this->character.animatable, char_xmasp_anim);
-	Character_Init((Character*)this, x, y);
+	Character_Init((Character*)this, sizeof(*this), x, y);
 	
 	//Set character information
 	this->character.spec = 0;
@@ -197,7 +196,7 @@ static Character *Char_XmasP_New(fixed_t x, fixed_t y)
 		*arc_ptr++ = Archive_Find((IO_Data)char_xmasp_arc_main, *pathp);
 	
 	//Initialize render state
-	this->tex_id = this->frame = 0xFF;
+	this->character.tex_id = this->character.frame = 0xFF;
 	
 	return (Character*)this;
 }
@@ -12,6 +12,7 @@
 #include "boot/io.h"
 #include "boot/gfx.h"
 #include "boot/audio.h"
+#include "boot/log.h"
 #include "boot/pad.h"
 #include "boot/archive.h"
 #include "boot/mutil.h"
@@ -35,7 +36,7 @@
 #include "character/menugf.c"
 
 //Girlfriend
-#include "character/gf.c"
+#include "boot/character/gf.h"
 
 u32 Menu_Sounds[3];
 
@@ -45,12 +46,6 @@ static fixed_t Char_MenuGF_GetParallax(Char_MenuGF *this)
 	return FIXED_UNIT;
 }
 
-static fixed_t Char_GF_GetParallax(Char_GF *this)
-{
-	(void)this;
-	return FIXED_UNIT;
-}
-
 //Menu messages
 static const char *funny_messages[][2] = {
 	{"PSX PORT BY CUCKYDEV", "YOU KNOW IT"},
@@ -374,7 +369,7 @@ void Menu_Load2(MenuPage page)
 	FontData_Arial(&menu.font_arial, overlay_data = Overlay_DataRead()); Mem_Free(overlay_data); //arial.tim
 	
 	//Initialize Girlfriend, Menu BF, Menu Opponents and stage
-	menu.gf = Char_GF_New(FIXED_DEC(62,1), FIXED_DEC(-12,1));
+	menu.gf = Char_GF_New(FIXED_DEC(62,1), FIXED_DEC(-12,1), FIXED_UNIT, NULL);
 	menu.bf = Char_BF_New(FIXED_DEC(0,1), FIXED_DEC( 37,1));
 	menu.opponent = Char_MenuO_New(FIXED_DEC(-90,1), FIXED_DEC(114,1));
 	menu.menugf = Char_MenuGF_New(FIXED_DEC(90,1), FIXED_DEC(15,1));
@@ -424,7 +419,7 @@ void Menu_Load2(MenuPage page)
     Menu_Sounds[2] = Audio_LoadVAGData(data, file.size);
     
 	for (int i = 0; i < 3; i++)
-	printf("address = %08x\n", Menu_Sounds[i]);
+		LOG_TRACE(LOG_MENU, "Menu sound %d at %08x", i, Menu_Sounds[i]);
 
 	Mem_Free(data);
 
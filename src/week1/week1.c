@@ -10,95 +10,33 @@
 #include "boot/archive.h"
 #include "boot/main.h"
 #include "boot/mem.h"
+#include "boot/character/generic.h"
 
-//Charts
-static u8 week1_cht_bopeebo_easy[] = {
-	#include "iso/chart/bopeebo-easy.json.cht.h"
-};
-static u8 week1_cht_bopeebo_normal[] = {
-	#include "iso/chart/bopeebo.json.cht.h"
-};
-static u8 week1_cht_bopeebo_hard[] = {
-	#include "iso/chart/bopeebo-hard.json.cht.h"
-};
-
-static u8 week1_cht_fresh_easy[] = {
-	#include "iso/chart/fresh-easy.json.cht.h"
-};
-static u8 week1_cht_fresh_normal[] = {
-	#include "iso/chart/fresh.json.cht.h"
-};
-static u8 week1_cht_fresh_hard[] = {
-	#include "iso/chart/fresh-hard.json.cht.h"
-};
-
-static u8 week1_cht_dadbattle_easy[] = {
-	#include "iso/chart/dadbattle-easy.json.cht.h"
-};
-static u8 week1_cht_dadbattle_normal[] = {
-	#include "iso/chart/dadbattle.json.cht.h"
-};
-static u8 week1_cht_dadbattle_hard[] = {
-	#include "iso/chart/dadbattle-hard.json.cht.h"
-};
-
-static u8 week1_cht_tutorial_normal[] = {
-	#include "iso/chart/tutorial.json.cht.h"
-};
-static u8 week1_cht_tutorial_hard[] = {
-	#include "iso/chart/tutorial-hard.json.cht.h"
-};
-
-static u8 week1_cht_test[] = {
-	#include "iso/chart/test.json.cht.h"
-};
-
-static IO_Data week1_cht[][3] = {
-	{
-		(IO_Data)week1_cht_bopeebo_easy,
-		(IO_Data)week1_cht_bopeebo_normal,
-		(IO_Data)week1_cht_bopeebo_hard,
-	},
-	{
-		(IO_Data)week1_cht_fresh_easy,
-		(IO_Data)week1_cht_fresh_normal,
-		(IO_Data)week1_cht_fresh_hard,
-	},
-	{
-		(IO_Data)week1_cht_dadbattle_easy,
-		(IO_Data)week1_cht_dadbattle_normal,
-		(IO_Data)week1_cht_dadbattle_hard,
-	},
-	{
-		(IO_Data)week1_cht_tutorial_normal,
-		(IO_Data)week1_cht_tutorial_normal,
-		(IO_Data)week1_cht_tutorial_hard,
-	},
-	{
-		(IO_Data)week1_cht_test,
-		(IO_Data)week1_cht_test,
-		(IO_Data)week1_cht_test,
-	},
+//Charts (overlay data indices, stored after the textures)
+static const u8 week1_cht[][3] = {
+	{ 4,  5,  6}, //bopeebo
+	{ 7,  8,  9}, //fresh
+	{10, 11, 12}, //dadbattle
+	{13, 13, 14}, //tutorial
+	{15, 15, 15}, //test
 };
 
 //Characters
 //Boyfriend
-#include "character/bf.c"
+#include "boot/character/bf.h"
 #include "character/bfweeb.c"
 
 //Daddy Dearest
-#include "character/dad.c"
+static u8 char_dad_arc_main[] = {
+	#include "iso/dad/main.arc.h"
+};
 
 //Girlfriend
-#define CHAR_GF_TUTORIAL
-#include "character/gf.c"
-#undef CHAR_GF_TUTORIAL
+#include "boot/character/gf.h"
 
-static fixed_t Char_GF_GetParallax(Char_GF *this)
-{
-	(void)this;
-	return FIXED_DEC(7,10);
-}
+static u8 char_gf_arc_tut[] = {
+	#include "iso/gf/tut.arc.h"
+};
 
 //Week 1 textures
 static Gfx_Tex week1_tex_back0; //Stage and back
@@ -124,20 +62,20 @@ static void Week1_Load(void)
 	{
 	case StageId_1_4:
 		//GF as opponent
-		stage.opponent = Char_GF_New(FIXED_DEC(0,1), FIXED_DEC(-10,1));
+		stage.opponent = Char_GF_New(FIXED_DEC(0,1), FIXED_DEC(-10,1), FIXED_DEC(7,10), (IO_Data)char_gf_arc_tut);
 		stage.gf = NULL;
 		break;
 
 	case StageId_4_4:
     	//BFWeeb as opponent
 		stage.opponent = Char_BFWeeb_New(FIXED_DEC(-120,1), FIXED_DEC(110,1));
-		stage.gf = Char_GF_New(FIXED_DEC(0,1), FIXED_DEC(-10,1));
+		stage.gf = Char_GF_New(FIXED_DEC(0,1), FIXED_DEC(-10,1), FIXED_DEC(7,10), (IO_Data)char_gf_arc_tut);
 		break;
 
 	default:
 		//Dad as opponent
-		stage.opponent = Char_Dad_New(FIXED_DEC(-120,1), FIXED_DEC(100,1));
-		stage.gf = Char_GF_New(FIXED_DEC(0,1), FIXED_DEC(-10,1));
+		stage.opponent = Char_Generic_New((IO_Data)char_dad_arc_main, FIXED_DEC(-120,1), FIXED_DEC(100,1));
+		stage.gf = Char_GF_New(FIXED_DEC(0,1), FIXED_DEC(-10,1), FIXED_DEC(7,10), (IO_Data)char_gf_arc_tut);
 		break;
 		}
 }
@@ -310,9 +248,9 @@ static void Week1_DrawBG()
 static IO_Data Week1_GetChart(void)
 {
 	if (stage.stage_id == StageId_4_4)
-	return week1_cht[4][stage.stage_diff];
+	return Overlay_DataReadAt(week1_cht[4][stage.stage_diff]);
 	else
-	return week1_cht[stage.stage_id - StageId_1_1][stage.stage_diff];
+	return Overlay_DataReadAt(week1_cht[stage.stage_id - StageId_1_1][stage.stage_diff]);
 }
 
 static boolean Week1_LoadScreen(void)
@@ -11,6 +11,8 @@
 #include "boot/main.h"
 #include "boot/mem.h"
 #include "boot/audio.h"
+#include "boot/log.h"
+#include "boot/timer.h"
 
 #include "stdlib.h"
 
@@ -21,58 +23,16 @@ fixed_t week2_thunderspd = FIXED_DEC(290,1);
 //thunder sound
 u32 Week2_Sounds[2];
 
-//Charts
-static u8 week2_cht_spookeez_easy[] = {
-	#include "iso/chart/spookeez-easy.json.cht.h"
-};
-static u8 week2_cht_spookeez_normal[] = {
-	#include "iso/chart/spookeez.json.cht.h"
-};
-static u8 week2_cht_spookeez_hard[] = {
-	#include "iso/chart/spookeez-hard.json.cht.h"
-};
-
-static u8 week2_cht_south_easy[] = {
-	#include "iso/chart/south-easy.json.cht.h"
-};
-static u8 week2_cht_south_normal[] = {
-	#include "iso/chart/south.json.cht.h"
-};
-static u8 week2_cht_south_hard[] = {
-	#include "iso/chart/south-hard.json.cht.h"
-};
-
-static u8 week2_cht_monster_easy[] = {
-	#include "iso/chart/monster-easy.json.cht.h"
-};
-static u8 week2_cht_monster_normal[] = {
-	#include "iso/chart/monster.json.cht.h"
-};
-static u8 week2_cht_monster_hard[] = {
-	#include "iso/chart/monster-hard.json.cht.h"
-};
-
-static IO_Data week2_cht[][3] = {
-	{
-		(IO_Data)week2_cht_spookeez_easy,
-		(IO_Data)week2_cht_spookeez_normal,
-		(IO_Data)week2_cht_spookeez_hard,
-	},
-	{
-		(IO_Data)week2_cht_south_easy,
-		(IO_Data)week2_cht_south_normal,
-		(IO_Data)week2_cht_south_hard,
-	},
-	{
-		(IO_Data)week2_cht_monster_easy,
-		(IO_Data)week2_cht_monster_normal,
-		(IO_Data)week2_cht_monster_hard,
-	},
+//Charts (overlay data indices, stored after the textures)
+static const u8 week2_cht[][3] = {
+	{ 5,  6,  7}, //spookeez
+	{ 8,  9, 10}, //south
+	{11, 12, 13}, //monster
 };
 
 //Characters
 //Boyfriend
-#include "character/bf.c"
+#include "boot/character/bf.h"
 
 //Spooky Kids
 #include "character/spook.c"
@@ -81,13 +41,7 @@ static IO_Data week2_cht[][3] = {
 #include "character/monster.c"
 
 //Girlfriend
-#include "character/gf.c"
-
-static fixed_t Char_GF_GetParallax(Char_GF *this)
-{
-	(void)this;
-	return FIXED_UNIT;
-}
+#include "boot/character/gf.h"
 
 //Week 2 textures
 static Gfx_Tex week2_tex_back0; //Background
@@ -120,7 +74,7 @@ static void Week2_Load(void)
 	else
 	stage.opponent = Char_Spook_New(FIXED_DEC(-90,1), FIXED_DEC(85,1));
 
-	stage.gf = Char_GF_New(FIXED_DEC(0,1), FIXED_DEC(-15,1));
+	stage.gf = Char_GF_New(FIXED_DEC(0,1), FIXED_DEC(-15,1), FIXED_UNIT, NULL);
 
 	//load thunder sound
 	CdlFILE file;
@@ -133,7 +87,7 @@ static void Week2_Load(void)
     Week2_Sounds[1] = Audio_LoadVAGData(data, file.size);
     
 	for (int i = 0; i < 2; i++)
-	printf("address = %08x\n", Week2_Sounds[i]);
+		LOG_TRACE(LOG_STAGE, "Week2 sound %d at %08x", i, Week2_Sounds[i]);
 
 	Mem_Free(data);
 
@@ -195,7 +149,9 @@ static void Week2_DrawBG()
 	fx = stage.camera.x;
 	fy = stage.camera.y;
     
-	FntPrint("lightwin %d", week2_anims);
+	#ifdef PSXF_DEBUG
+		FntPrint("lightwin %d", week2_anims);
+	#endif
 	
 	if (week2_lightanim == true)
 	{
@@ -247,7 +203,7 @@ static void Week2_DrawBG()
 
 static IO_Data Week2_GetChart(void)
 {
-	return week2_cht[stage.stage_id - StageId_2_1][stage.stage_diff];
+	return Overlay_DataReadAt(week2_cht[stage.stage_id - StageId_2_1][stage.stage_diff]);
 }
 
 static boolean Week2_LoadScreen(void)
@@ -11,74 +11,30 @@
 #include "boot/archive.h"
 #include "boot/main.h"
 #include "boot/mem.h"
+#include "boot/timer.h"
+#include "boot/character/generic.h"
 
 fixed_t week3_fade;
 fixed_t week3_fadespd = FIXED_DEC(150,1);
 
-//Charts
-static u8 week3_cht_pico_easy[] = {
-	#include "iso/chart/pico-easy.json.cht.h"
-};
-static u8 week3_cht_pico_normal[] = {
-	#include "iso/chart/pico.json.cht.h"
-};
-static u8 week3_cht_pico_hard[] = {
-	#include "iso/chart/pico-hard.json.cht.h"
-};
-
-static u8 week3_cht_philly_easy[] = {
-	#include "iso/chart/philly-easy.json.cht.h"
-};
-static u8 week3_cht_philly_normal[] = {
-	#include "iso/chart/philly.json.cht.h"
-};
-static u8 week3_cht_philly_hard[] = {
-	#include "iso/chart/philly-hard.json.cht.h"
-};
-
-static u8 week3_cht_blammed_easy[] = {
-	#include "iso/chart/blammed-easy.json.cht.h"
-};
-static u8 week3_cht_blammed_normal[] = {
-	#include "iso/chart/blammed.json.cht.h"
-};
-static u8 week3_cht_blammed_hard[] = {
-	#include "iso/chart/blammed-hard.json.cht.h"
-};
-
-static IO_Data week3_cht[][3] = {
-	{
-		(IO_Data)week3_cht_pico_easy,
-		(IO_Data)week3_cht_pico_normal,
-		(IO_Data)week3_cht_pico_hard,
-	},
-	{
-		(IO_Data)week3_cht_philly_easy,
-		(IO_Data)week3_cht_philly_normal,
-		(IO_Data)week3_cht_philly_hard,
-	},
-	{
-		(IO_Data)week3_cht_blammed_easy,
-		(IO_Data)week3_cht_blammed_normal,
-		(IO_Data)week3_cht_blammed_hard,
-	},
+//Charts (overlay data indices, stored after the textures)
+static const u8 week3_cht[][3] = {
+	{ 8,  9, 10}, //pico
+	{11, 12, 13}, //philly
+	{14, 15, 16}, //blammed
 };
 
 //Characters
 //Boyfriend
-#include "character/bf.c"
+#include "boot/character/bf.h"
 
 //Pico
-#include "character/pico.c"
+static u8 char_pico_arc_main[] = {
+	#include "iso/pico/main.arc.h"
+};
 
 //Girlfriend
-#include "character/gf.c"
-
-static fixed_t Char_GF_GetParallax(Char_GF *this)
-{
-	(void)this;
-	return FIXED_UNIT;
-}
+#include "boot/character/gf.h"
 
 //Week 3 textures
 static Gfx_Tex week3_tex_back0; //Buildings
@@ -119,8 +75,8 @@ static void Week3_Load(void)
 	
 	//Load characters
 	stage.player = Char_BF_New(FIXED_DEC(56,1), FIXED_DEC(85,1));
-	stage.opponent = Char_Pico_New(FIXED_DEC(-105,1), FIXED_DEC(85,1));
-	stage.gf = Char_GF_New(FIXED_DEC(0,1), FIXED_DEC(-15,1));
+	stage.opponent = Char_Generic_New((IO_Data)char_pico_arc_main, FIXED_DEC(-105,1), FIXED_DEC(85,1));
+	stage.gf = Char_GF_New(FIXED_DEC(0,1), FIXED_DEC(-15,1), FIXED_UNIT, NULL);
 	
 	//Initialize window state
 	week3_win_time = -1;
@@ -366,7 +322,7 @@ static void Week3_DrawBG()
 
 static IO_Data Week3_GetChart(void)
 {
-	return week3_cht[stage.stage_id - StageId_3_1][stage.stage_diff];
+	return Overlay_DataReadAt(week3_cht[stage.stage_id - StageId_3_1][stage.stage_diff]);
 }
 
 static boolean Week3_LoadScreen(void)
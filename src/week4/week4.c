@@ -11,53 +11,11 @@
 #include "boot/main.h"
 #include "boot/mem.h"
 
-//Charts
-static u8 week4_cht_satin_panties_easy[] = {
-	#include "iso/chart/satin-panties-easy.json.cht.h"
-};
-static u8 week4_cht_satin_panties_normal[] = {
-	#include "iso/chart/satin-panties.json.cht.h"
-};
-static u8 week4_cht_satin_panties_hard[] = {
-	#include "iso/chart/satin-panties-hard.json.cht.h"
-};
-
-static u8 week4_cht_high_easy[] = {
-	#include "iso/chart/high-easy.json.cht.h"
-};
-static u8 week4_cht_high_normal[] = {
-	#include "iso/chart/high.json.cht.h"
-};
-static u8 week4_cht_high_hard[] = {
-	#include "iso/chart/high-hard.json.cht.h"
-};
-
-static u8 week4_cht_milf_easy[] = {
-	#include "iso/chart/milf-easy.json.cht.h"
-};
-static u8 week4_cht_milf_normal[] = {
-	#include "iso/chart/milf.json.cht.h"
-};
-static u8 week4_cht_milf_hard[] = {
-	#include "iso/chart/milf-hard.json.cht.h"
-};
-
-static IO_Data week4_cht[][3] = {
-	{
-		(IO_Data)week4_cht_satin_panties_easy,
-		(IO_Data)week4_cht_satin_panties_normal,
-		(IO_Data)week4_cht_satin_panties_hard,
-	},
-	{
-		(IO_Data)week4_cht_high_easy,
-		(IO_Data)week4_cht_high_normal,
-		(IO_Data)week4_cht_high_hard,
-	},
-	{
-		(IO_Data)week4_cht_milf_easy,
-		(IO_Data)week4_cht_milf_normal,
-		(IO_Data)week4_cht_milf_hard,
-	},
+//Charts (overlay data indices, stored after the textures)
+static const u8 week4_cht[][3] = {
+	{ 7,  8,  9}, //satin-panties
+	{10, 11, 12}, //high
+	{13, 14, 15}, //milf
 };
 
 //Characters
@@ -68,13 +26,7 @@ static IO_Data week4_cht[][3] = {
 #include "character/mom.c"
 
 //Girlfriend
-#include "character/gf.c"
-
-static fixed_t Char_GF_GetParallax(Char_GF *this)
-{
-	(void)this;
-	return FIXED_UNIT;
-}
+#include "boot/character/gf.h"
 
 //Henchmen assets
 static const CharFrame henchmen_frame[] = {
@@ -169,7 +121,7 @@ static void Week4_Load(void)
 	//Load characters
 	stage.player = Char_BFCar_New(FIXED_DEC(120,1), FIXED_DEC(40,1));
 	stage.opponent = Char_Mom_New(FIXED_DEC(-120,1), FIXED_DEC(100,1));
-	stage.gf = Char_GF_New(FIXED_DEC(0,1), FIXED_DEC(-10,1));
+	stage.gf = Char_GF_New(FIXED_DEC(0,1), FIXED_DEC(-10,1), FIXED_UNIT, NULL);
 	
 	//Load henchmen textures
 	week4_arc_hench_ptr[0] = Archive_Find((IO_Data)week4_arc_hench, "hench0.tim");
@@ -299,7 +251,7 @@ static void Week4_DrawFG()
 
 static IO_Data Week4_GetChart(void)
 {
-	return week4_cht[stage.stage_id - StageId_4_1][stage.stage_diff];
+	return Overlay_DataReadAt(week4_cht[stage.stage_id - StageId_4_1][stage.stage_diff]);
 }
 
 static boolean Week4_LoadScreen(void)
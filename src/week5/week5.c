@@ -11,53 +11,11 @@
 #include "boot/main.h"
 #include "boot/mem.h"
 
-//Charts
-static u8 week5_cht_cocoa_easy[] = {
-	#include "iso/chart/cocoa-easy.json.cht.h"
-};
-static u8 week5_cht_cocoa_normal[] = {
-	#include "iso/chart/cocoa.json.cht.h"
-};
-static u8 week5_cht_cocoa_hard[] = {
-	#include "iso/chart/cocoa-hard.json.cht.h"
-};
-
-static u8 week5_cht_eggnog_easy[] = {
-	#include "iso/chart/eggnog-easy.json.cht.h"
-};
-static u8 week5_cht_eggnog_normal[] = {
-	#include "iso/chart/eggnog.json.cht.h"
-};
-static u8 week5_cht_eggnog_hard[] = {
-	#include "iso/chart/eggnog-hard.json.cht.h"
-};
-
-static u8 week5_cht_winter_horrorland_easy[] = {
-	#include "iso/chart/winter-horrorland-easy.json.cht.h"
-};
-static u8 week5_cht_winter_horrorland_normal[] = {
-	#include "iso/chart/winter-horrorland.json.cht.h"
-};
-static u8 week5_cht_winter_horrorland_hard[] = {
-	#include "iso/chart/winter-horrorland-hard.json.cht.h"
-};
-
-static IO_Data week5_cht[][3] = {
-	{
-		(IO_Data)week5_cht_cocoa_easy,
-		(IO_Data)week5_cht_cocoa_normal,
-		(IO_Data)week5_cht_cocoa_hard,
-	},
-	{
-		(IO_Data)week5_cht_eggnog_easy,
-		(IO_Data)week5_cht_eggnog_normal,
-		(IO_Data)week5_cht_eggnog_hard,
-	},
-	{
-		(IO_Data)week5_cht_winter_horrorland_easy,
-		(IO_Data)week5_cht_winter_horrorland_normal,
-		(IO_Data)week5_cht_winter_horrorland_hard,
-	},
+//Charts (overlay data indices, stored after the textures)
+static const u8 week5_cht[][3] = {
+	{ 9, 10, 11}, //cocoa
+	{12, 13, 14}, //eggnog
+	{15, 16, 17}, //winter-horrorland
 };
 
 //Characters
@@ -355,7 +313,7 @@ static void Week5_DrawBGEvil()
 
 static IO_Data Week5_GetChart(void)
 {
-	return week5_cht[stage.stage_id - StageId_5_1][stage.stage_diff];
+	return Overlay_DataReadAt(week5_cht[stage.stage_id - StageId_5_1][stage.stage_diff]);
 }
 
 static boolean Week5_LoadScreen(void)
@@ -14,6 +14,7 @@
 
 #include "boot/font.h"
 #include "boot/audio.h"
+#include "boot/log.h"
 
 //OG dialog code by bilious
 //changes and improvements by igorsou3000(me LOL)
@@ -31,53 +32,11 @@ u8 week6_setsize;
 //week6 sounds
 u32 Week6_Sounds[1];
 
-//Charts
-static u8 week6_cht_senpai_easy[] = {
-	#include "iso/chart/senpai-easy.json.cht.h"
-};
-static u8 week6_cht_senpai_normal[] = {
-	#include "iso/chart/senpai.json.cht.h"
-};
-static u8 week6_cht_senpai_hard[] = {
-	#include "iso/chart/senpai-hard.json.cht.h"
-};
-
-static u8 week6_cht_roses_easy[] = {
-	#include "iso/chart/roses-easy.json.cht.h"
-};
-static u8 week6_cht_roses_normal[] = {
-	#include "iso/chart/roses.json.cht.h"
-};
-static u8 week6_cht_roses_hard[] = {
-	#include "iso/chart/roses-hard.json.cht.h"
-};
-
-static u8 week6_cht_thorns_easy[] = {
-	#include "iso/chart/thorns-easy.json.cht.h"
-};
-static u8 week6_cht_thorns_normal[] = {
-	#include "iso/chart/thorns.json.cht.h"
-};
-static u8 week6_cht_thorns_hard[] = {
-	#include "iso/chart/thorns-hard.json.cht.h"
-};
-
-static IO_Data week6_cht[][3] = {
-	{
-		(IO_Data)week6_cht_senpai_easy,
-		(IO_Data)week6_cht_senpai_normal,
-		(IO_Data)week6_cht_senpai_hard,
-	},
-	{
-		(IO_Data)week6_cht_roses_easy,
-		(IO_Data)week6_cht_roses_normal,
-		(IO_Data)week6_cht_roses_hard,
-	},
-	{
-		(IO_Data)week6_cht_thorns_easy,
-		(IO_Data)week6_cht_thorns_normal,
-		(IO_Data)week6_cht_thorns_hard,
-	}
+//Charts (overlay data indices, stored after the textures)
+static const u8 week6_cht[][3] = {
+	{ 7,  8,  9}, //senpai
+	{10, 11, 12}, //roses
+	{13, 14, 15}, //thorns
 };
 
 //Freaks assets
@@ -363,7 +322,7 @@ static void Week6_Load(void)
     Week6_Sounds[0] = Audio_LoadVAGData(data, file.size);
 
 	for (int i = 0; i < 1; i++)
-	printf("address = %08x\n", Week6_Sounds[i]);
+		LOG_TRACE(LOG_STAGE, "Week6 sound %d at %08x", i, Week6_Sounds[i]);
 
 	Mem_Free(data);
 }
@@ -418,18 +377,25 @@ static void Week6_DrawBG3(void)
 		}
 	}
 	
-	//Draw 32x32 quads of the background
+	//Draw 32x32 quads of the background in one batch
+	StageQuad back_quad[5 * 8];
+	StageQuad *quad = back_quad;
 	for (int y = 0; y < 5; y++)
 	{
 		RECT back_src = {0, y * 32, 32, 32};
-		for (int x = 0; x < 8; x++)
+		for (int x = 0; x < 8; x++, quad++)
 		{
-			//Draw quad and increment source rect
-			Stage_DrawTexArb(&week6_tex_back3, &back_src, &back_dst[y][x], &back_dst[y][x + 1], &back_dst[y + 1][x], &back_dst[y + 1][x + 1], stage.camera.bzoom);
+			//Add quad and increment source rect
+			quad->src = back_src;
+			quad->p[0] = back_dst[y][x];
+			quad->p[1] = back_dst[y][x + 1];
+			quad->p[2] = back_dst[y + 1][x];
+			quad->p[3] = back_dst[y + 1][x + 1];
 			if ((back_src.x += 32) >= 0xE0)
 				back_src.w--;
 		}
 	}
+	Stage_DrawQuadBatch(&week6_tex_back3, back_quad, COUNT_OF(back_quad), stage.camera.bzoom, 0x80, 0x80, 0x80, STAGE_QUAD_OPAQUE);
 }
 static void Week6_DrawBG(void)
 {
@@ -570,7 +536,7 @@ static void Week6_DrawBG(void)
 
 static IO_Data Week6_GetChart(void)
 {
-	return week6_cht[stage.stage_id - StageId_6_1][stage.stage_diff];
+	return Overlay_DataReadAt(week6_cht[stage.stage_id - StageId_6_1][stage.stage_diff]);
 }
 
 static boolean Week6_LoadScreen(void)
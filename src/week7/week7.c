@@ -12,70 +12,22 @@
 #include "boot/mutil.h"
 #include "boot/timer.h"
 
-//Charts
-static u8 week7_cht_ugh_easy[] = {
-	#include "iso/chart/ugh-easy.json.cht.h"
-};
-static u8 week7_cht_ugh_normal[] = {
-	#include "iso/chart/ugh.json.cht.h"
-};
-static u8 week7_cht_ugh_hard[] = {
-	#include "iso/chart/ugh-hard.json.cht.h"
-};
-
-static u8 week7_cht_guns_easy[] = {
-	#include "iso/chart/guns-easy.json.cht.h"
-};
-static u8 week7_cht_guns_normal[] = {
-	#include "iso/chart/guns.json.cht.h"
-};
-static u8 week7_cht_guns_hard[] = {
-	#include "iso/chart/guns-hard.json.cht.h"
-};
-
-static u8 week7_cht_stress_easy[] = {
-	#include "iso/chart/stress-easy.json.cht.h"
-};
-static u8 week7_cht_stress_normal[] = {
-	#include "iso/chart/stress.json.cht.h"
-};
-static u8 week7_cht_stress_hard[] = {
-	#include "iso/chart/stress-hard.json.cht.h"
-};
-
-static IO_Data week7_cht[][3] = {
-	{
-		(IO_Data)week7_cht_ugh_easy,
-		(IO_Data)week7_cht_ugh_normal,
-		(IO_Data)week7_cht_ugh_hard,
-	},
-	{
-		(IO_Data)week7_cht_guns_easy,
-		(IO_Data)week7_cht_guns_normal,
-		(IO_Data)week7_cht_guns_hard,
-	},
-	{
-		(IO_Data)week7_cht_stress_easy,
-		(IO_Data)week7_cht_stress_normal,
-		(IO_Data)week7_cht_stress_hard,
-	}
+//Charts (overlay data indices, stored after the textures)
+static const u8 week7_cht[][3] = {
+	{ 6,  7,  8}, //ugh
+	{ 9, 10, 11}, //guns
+	{12, 13, 14}, //stress
 };
 
 //Characters
 //Boyfriend
-#include "character/bf.c"
+#include "boot/character/bf.h"
 
 //Senpai
 #include "character/tank.c"
 
 //Girlfriend
-#include "character/gf.c"
-
-static fixed_t Char_GF_GetParallax(Char_GF *this)
-{
-	(void)this;
-	return FIXED_UNIT;
-}
+#include "boot/character/gf.h"
 
 //Week7 Textures
 static Gfx_Tex week7_tex_back0; //Background
@@ -112,7 +64,7 @@ static void Week7_Load(void)
 	//Load characters
 	stage.player = Char_BF_New(FIXED_DEC(105,1),  FIXED_DEC(100,1));
 	stage.opponent = Char_Tank_New(FIXED_DEC(-120,1),  FIXED_DEC(100,1));
-	stage.gf = Char_GF_New(FIXED_DEC(0,1),  FIXED_DEC(-15,1));
+	stage.gf = Char_GF_New(FIXED_DEC(0,1),  FIXED_DEC(-15,1), FIXED_UNIT, NULL);
 
 	//Initialize tank state
     week7_tank_x = TANK_END_X;
@@ -292,7 +244,7 @@ static void Week7_DrawBG(void)
 
 static IO_Data Week7_GetChart(void)
 {
-	return week7_cht[stage.stage_id - StageId_7_1][stage.stage_diff];
+	return Overlay_DataReadAt(week7_cht[stage.stage_id - StageId_7_1][stage.stage_diff]);
 }
 
 static boolean Week7_LoadScreen(void)
@@ -0,0 +1,186 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+//Character snapshots
+//Retries restore characters from a snapshot, which on story songs is taken after the previous song
+//already loaded sheets, checks the character always draws a frame from the sheet that's in VRAM
+
+#include "test.h"
+
+#include "character.h"
+#include "mem.h"
+#include "stage.h"
+
+//Test constants
+#define CHAR_TICKS 240
+
+fixed_t timer_dt;
+Stage stage;
+
+void Stage_DrawTex(Gfx_Tex *tex, const RECT *src, const RECT_FIXED *dst, fixed_t zoom)
+{
+	(void)tex;
+	(void)src;
+	(void)dst;
+	(void)zoom;
+}
+
+//VRAM model, the sheet the character's texture page holds
+static u32 sheet_data[2] = {0, 1};
+static u8 vram_sheet;
+static u32 sheet_loads;
+
+void Gfx_LoadTex(Gfx_Tex *tex, IO_Data data, Gfx_LoadTex_Flag flag)
+{
+	(void)tex;
+	(void)flag;
+	vram_sheet = *data;
+	sheet_loads++;
+}
+
+//Test character, two frames on each of two sheets, set up like the built in characters
+enum
+{
+	TestAnim_Idle = CharAnim_Idle, //Sheet 1
+	TestAnim_Sing = CharAnim_Left, //Sheet 0
+};
+
+static const CharFrame char_test_frame[] = {
+	{0, {  0, 0, 64, 64}, {0, 0}},
+	{0, { 64, 0, 64, 64}, {0, 0}},
+	{1, {  0, 0, 64, 64}, {0, 0}},
+	{1, { 64, 0, 64, 64}, {0, 0}},
+};
+
+static const Animation char_test_anim[CharAnim_Max] = {
+	{2, (const u8[]){2, 3, ASCR_BACK, 1}},        //CharAnim_Idle
+	{2, (const u8[]){0, 1, ASCR_BACK, 1}},        //CharAnim_Left
+	{0, (const u8[]){ASCR_CHGANI, CharAnim_Idle}}, //CharAnim_LeftAlt
+	{0, (const u8[]){ASCR_CHGANI, CharAnim_Idle}}, //CharAnim_Down
+	{0, (const u8[]){ASCR_CHGANI, CharAnim_Idle}}, //CharAnim_DownAlt
+	{0, (const u8[]){ASCR_CHGANI, CharAnim_Idle}}, //CharAnim_Up
+	{0, (const u8[]){ASCR_CHGANI, CharAnim_Idle}}, //CharAnim_UpAlt
+	{0, (const u8[]){ASCR_CHGANI, CharAnim_Idle}}, //CharAnim_Right
+	{0, (const u8[]){ASCR_CHGANI, CharAnim_Idle}}, //CharAnim_RightAlt
+};
+
+typedef struct
+{
+	//Character base structure
+	Character character;
+
+	//Render data and state
+	IO_Data arc_ptr[2];
+	Gfx_Tex tex;
+} Char_Test;
+
+static void Char_Test_SetFrame(void *user, u8 frame)
+{
+	Char_Test *this = (Char_Test*)user;
+
+	//Check if this is a new frame
+	if (frame != this->character.frame)
+	{
+		//Check if new art shall be loaded
+		const CharFrame *cframe = &char_test_frame[this->character.frame = frame];
+		if (cframe->tex != this->character.tex_id)
+			Gfx_LoadTex(&this->tex, this->arc_ptr[this->character.tex_id = cframe->tex], 0);
+	}
+}
+
+static void Char_Test_Tick(Character *character)
+{
+	Char_Test *this = (Char_Test*)character;
+	Animatable_Animate(&character->animatable, (void*)this, Char_Test_SetFrame);
+
+	//What would be drawn has to come from the sheet in VRAM
+	TEST_CHECK(character->frame < COUNT_OF(char_test_frame), "drew frame %d", character->frame);
+	if (character->frame < COUNT_OF(char_test_frame))
+		TEST_CHECK(char_test_frame[character->frame].tex == vram_sheet, "drew frame %d from sheet %d with sheet %d in VRAM",
+			character->frame, char_test_frame[character->frame].tex, vram_sheet);
+}
+
+static void Char_Test_SetAnim(Character *character, u8 anim)
+{
+	Animatable_SetAnim(&character->animatable, anim);
+	Character_CheckStartSing(character);
+}
+
+static void Char_Test_Free(Character *character)
+{
+	(void)character;
+}
+
+static Character *Char_Test_New(void)
+{
+	Char_Test *this = Mem_Alloc(sizeof(Char_Test));
+
+	this->character.tick = Char_Test_Tick;
+	this->character.set_anim = Char_Test_SetAnim;
+	this->character.free = Char_Test_Free;
+
+	Animatable_Init(&this->character.animatable, char_test_anim);
+	Character_Init((Character*)this, sizeof(Char_Test), 0, 0);
+
+	this->arc_ptr[0] = &sheet_data[0];
+	this->arc_ptr[1] = &sheet_data[1];
+	this->character.tex_id = this->character.frame = 0xFF;
+	return (Character*)this;
+}
+
+static void Char_Play(Character *character, u32 ticks)
+{
+	for (u32 i = 0; i < ticks; i++)
+		character->tick(character);
+}
+
+//Tests
+static void Character_TestRetry(void)
+{
+	//First song, the snapshot is taken before the first tick
+	Character *character = Char_Test_New();
+	Character *snapshot = Character_Snapshot(character);
+	Char_Play(character, CHAR_TICKS);
+
+	//Retry after singing, the sheet changed since the snapshot
+	character->set_anim(character, TestAnim_Sing);
+	Char_Play(character, CHAR_TICKS);
+	TEST_CHECK(vram_sheet == 0, "singing left sheet %d in VRAM", vram_sheet);
+	Character_Restore(character, snapshot);
+	Char_Play(character, CHAR_TICKS);
+	Mem_Free(snapshot);
+
+	//Next story song, the snapshot is taken while idling with sheet 1 loaded
+	character->set_anim(character, TestAnim_Idle);
+	Char_Play(character, CHAR_TICKS);
+	snapshot = Character_Snapshot(character);
+	TEST_CHECK(snapshot->tex_id == 1, "story snapshot taken with sheet %d", snapshot->tex_id);
+
+	//Die singing and retry, the idle sheet has to be loaded again
+	character->set_anim(character, TestAnim_Sing);
+	Char_Play(character, CHAR_TICKS);
+	u32 loads = sheet_loads;
+	Character_Restore(character, snapshot);
+	Char_Play(character, 1);
+	TEST_CHECK(vram_sheet == 1 && sheet_loads == loads + 1, "retry left sheet %d in VRAM after %u load(s)", vram_sheet, sheet_loads - loads);
+	Char_Play(character, CHAR_TICKS);
+
+	//Retrying again without dying on another sheet still draws the right one
+	Character_Restore(character, snapshot);
+	Char_Play(character, CHAR_TICKS);
+
+	Mem_Free(snapshot);
+	Character_Free(character);
+}
+
+int main(void)
+{
+	timer_dt = FIXED_DEC(1,60);
+
+	Character_TestRetry();
+
+	return Test_Result("character");
+}
@@ -0,0 +1,182 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+//Chart round trip
+//Writes random json charts, packs them with funkinchtpak, expands them with the game's
+//decoder and compares against the notes the old uncompressed format stored
+
+#include "test.h"
+
+#include "chart.h"
+
+//Test constants
+#define CHART_BPM   150 //100ms steps, so 1/12 step positions round trip exactly
+#define CHART_STEP  100.0
+#define CHART_NOTES 0x3000
+
+//Expected notes, in the order the old format stored them
+static Note expect[CHART_NOTES];
+static size_t expect_num;
+
+static Note got[CHART_NOTES];
+
+static int Chart_Compare(const void *a, const void *b)
+{
+	//Same order as the old packer, heads before sustain pieces, then by type to make it total
+	const Note *na = (const Note*)a, *nb = (const Note*)b;
+	if (na->pos != nb->pos)
+		return (na->pos < nb->pos) ? -1 : 1;
+	if ((na->type & NOTE_FLAG_SUSTAIN) != (nb->type & NOTE_FLAG_SUSTAIN))
+		return (na->type & NOTE_FLAG_SUSTAIN) ? 1 : -1;
+	return (int)na->type - (int)nb->type;
+}
+
+static void Chart_Expect(u16 pos, u16 type, u16 len)
+{
+	//Head, then the sustain pieces the old packer wrote after it
+	expect[expect_num].pos = pos;
+	expect[expect_num++].type = type;
+	for (u16 k = 1; k <= len; k++)
+	{
+		expect[expect_num].pos = pos + k * 12;
+		expect[expect_num++].type = (type | NOTE_FLAG_SUSTAIN) & ((k == len) ? 0xFF : ~NOTE_FLAG_SUSTAIN_END);
+	}
+}
+
+static u16 Chart_Write(const char *path, u16 num_sections, s32 gap_max)
+{
+	FILE *fp = fopen(path, "w");
+	if (fp == NULL)
+	{
+		printf("failed to open %s\n", path);
+		exit(1);
+	}
+
+	expect_num = 0;
+	fprintf(fp, "{\"song\":{\"bpm\":%d,\"speed\":2.5,\"notes\":[\n", CHART_BPM);
+
+	//Keep sustains in a lane from overlapping so the packer never runs out of slots
+	s32 lane_free[8] = {0};
+	for (u16 s = 0; s < num_sections; s++)
+	{
+		boolean must_hit = Test_Random() & 1;
+		boolean alt = (Test_Random() & 7) == 0;
+		fprintf(fp, "%s{\"mustHitSection\":%s,\"altAnim\":%s,\"sectionNotes\":[", (s != 0) ? ",\n" : "", must_hit ? "true" : "false", alt ? "true" : "false");
+
+		s32 pos = s * 16 * 12;
+		s32 end = pos + 16 * 12;
+		boolean first = true;
+		while ((pos += Test_Range(0, gap_max)) < end)
+		{
+			u8 lane = Test_Random() & 7;
+			if (pos < lane_free[lane])
+				continue;
+
+			u16 len = (Test_Random() & 1) ? Test_Range(1, 12) : 0;
+			boolean mine = (Test_Random() & 15) == 0;
+			boolean note_alt = (Test_Random() & 15) == 0;
+			lane_free[lane] = pos + len * 12 + 1;
+
+			fprintf(fp, "%s[%.6f,%d,%d,%s]", first ? "" : ",", pos * CHART_STEP / 12.0, lane | (mine ? 8 : 0), len * (int)CHART_STEP, note_alt ? "true" : "false");
+			first = false;
+
+			//Type the way funkinchtpak derives it
+			u16 type = lane;
+			if (!must_hit)
+				type ^= NOTE_FLAG_OPPONENT;
+			if (note_alt || ((type & NOTE_FLAG_OPPONENT) && alt))
+				type |= NOTE_FLAG_ALT_ANIM;
+			if (len != 0)
+				type |= NOTE_FLAG_SUSTAIN_END;
+			if (mine)
+				type |= NOTE_FLAG_MINE;
+			Chart_Expect(pos, type, len);
+		}
+		fprintf(fp, "]}");
+	}
+
+	fprintf(fp, "\n]}}\n");
+	fclose(fp);
+	return num_sections;
+}
+
+static void Chart_RoundTrip(const char *packer, const char *path, u16 num_sections, s32 gap_max)
+{
+	//Write and pack chart
+	Chart_Write(path, num_sections, gap_max);
+
+	char cmd[512];
+	sprintf(cmd, "%s %s > /dev/null", packer, path);
+	if (system(cmd) != 0)
+	{
+		TEST_CHECK(0, "%s failed on %s", packer, path);
+		return;
+	}
+
+	//Read packed chart
+	sprintf(cmd, "%s.cht", path);
+	FILE *fp = fopen(cmd, "rb");
+	if (fp == NULL)
+	{
+		TEST_CHECK(0, "%s wasn't written", cmd);
+		return;
+	}
+	static u8 data[0x40000];
+	size_t size = fread(data, 1, sizeof(data), fp);
+	fclose(fp);
+
+	u16 pack_sections = data[4] | (data[5] << 8);
+	u16 pack_heads = data[6] | (data[7] << 8);
+	u16 pack_notes = data[8] | (data[9] << 8);
+	TEST_CHECK(pack_sections == num_sections + 1, "%u sections packed, expected %u", pack_sections, num_sections + 1);
+	TEST_CHECK(pack_notes == expect_num + 1, "%u notes packed, expected %u", pack_notes, (unsigned)expect_num + 1);
+	if (pack_notes > CHART_NOTES)
+		return;
+
+	//Expand with the game's decoder, it must stop exactly at the dummy note
+	const u8 *heads = data + 10 + pack_sections * sizeof(Section);
+	Note *end = Chart_ExpandHeads(got, got + pack_notes - 1, heads, pack_heads);
+	size_t got_num = end - got;
+	TEST_CHECK(got_num == expect_num, "expanded %u notes, expected %u", (unsigned)got_num, (unsigned)expect_num);
+	TEST_CHECK(heads <= data + size, "heads start past the end of the file");
+
+	//The game walks notes in order, pieces and heads must come out sorted
+	for (size_t i = 1; i < got_num; i++)
+	{
+		boolean sorted = got[i - 1].pos < got[i].pos ||
+			(got[i - 1].pos == got[i].pos && !((got[i - 1].type & NOTE_FLAG_SUSTAIN) && !(got[i].type & NOTE_FLAG_SUSTAIN)));
+		TEST_CHECK(sorted, "note %u (%u/%02X) comes after %u/%02X", (unsigned)i, got[i].pos, got[i].type, got[i - 1].pos, got[i - 1].type);
+	}
+
+	//Same notes at the same positions, pieces sharing a position may come out in any order
+	qsort(expect, expect_num, sizeof(Note), Chart_Compare);
+	qsort(got, got_num, sizeof(Note), Chart_Compare);
+	for (size_t i = 0; i < got_num && i < expect_num; i++)
+	{
+		TEST_CHECK(got[i].pos == expect[i].pos && got[i].type == expect[i].type,
+			"note %u is %u/%02X, expected %u/%02X", (unsigned)i, got[i].pos, got[i].type, expect[i].pos, expect[i].type);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 3)
+	{
+		printf("usage: chart funkinchtpak tmp_json\n");
+		return 1;
+	}
+
+	Test_Seed(0x46554E4B);
+
+	//Dense charts overlap sustains in every lane, sparse ones need multi-byte deltas
+	for (int i = 0; i < 8; i++)
+		Chart_RoundTrip(argv[1], argv[2], Test_Range(1, 64), 24);
+	for (int i = 0; i < 4; i++)
+		Chart_RoundTrip(argv[1], argv[2], Test_Range(32, 160), 192 * 3);
+	Chart_RoundTrip(argv[1], argv[2], 8, 1);
+
+	return Test_Result("chart");
+}
@@ -0,0 +1,147 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+//Fill-rate estimates
+//Checks the rect and quad areas the PSX counts fill with against a pixel count and against
+//clipping the quad to the screen exactly, including twisted and far off-screen quads
+
+#include "test.h"
+
+#include "gfx.h"
+
+//Test constants
+#define FILL_RECTS 2000
+#define FILL_QUADS 3000
+#define FILL_ERROR 52 //Pixels, from rounding clipped points to sub-pixels on long edges
+
+//Reference clipping, 0-1-3-2 clipped to the screen in long doubles then the shoelace
+static long double Ref_Inside(u8 edge, long double x, long double y)
+{
+	switch (edge)
+	{
+		case 0:
+			return x;
+		case 1:
+			return SCREEN_WIDTH - x;
+		case 2:
+			return y;
+		default:
+			return SCREEN_HEIGHT - y;
+	}
+}
+
+static long double Ref_QuadArea(const POINT *p0, const POINT *p1, const POINT *p2, const POINT *p3)
+{
+	long double px[2][20] = {{p0->x, p1->x, p3->x, p2->x}};
+	long double py[2][20] = {{p0->y, p1->y, p3->y, p2->y}};
+	u8 n = 4;
+	for (u8 edge = 0; edge < 4; edge++)
+	{
+		const long double *ix = px[edge & 1], *iy = py[edge & 1];
+		long double *ox = px[(edge & 1) ^ 1], *oy = py[(edge & 1) ^ 1];
+		u8 m = 0;
+		for (u8 i = 0; i < n; i++)
+		{
+			u8 j = (i + 1 == n) ? 0 : (i + 1);
+			long double di = Ref_Inside(edge, ix[i], iy[i]);
+			long double dj = Ref_Inside(edge, ix[j], iy[j]);
+			if (di >= 0)
+			{
+				ox[m] = ix[i];
+				oy[m++] = iy[i];
+			}
+			if ((di < 0) != (dj < 0))
+			{
+				ox[m] = ix[i] + (ix[j] - ix[i]) * di / (di - dj);
+				oy[m++] = iy[i] + (iy[j] - iy[i]) * di / (di - dj);
+			}
+		}
+		if ((n = m) < 3)
+			return 0;
+	}
+
+	long double area = 0;
+	for (u8 i = 0; i < n; i++)
+	{
+		u8 j = (i + 1 == n) ? 0 : (i + 1);
+		area += px[0][i] * py[0][j] - px[0][j] * py[0][i];
+	}
+	return ((area < 0) ? -area : area) / 2;
+}
+
+static void Fill_RandomPoint(POINT *p, u8 range)
+{
+	switch (range)
+	{
+		case 0: //Anywhere a s16 reaches
+			p->x = Test_Range(-0x8000, 0x7FFF);
+			p->y = Test_Range(-0x8000, 0x7FFF);
+			break;
+		case 1: //Around the screen
+			p->x = Test_Range(-340, 660);
+			p->y = Test_Range(-280, 520);
+			break;
+		default: //On screen
+			p->x = Test_Range(0, SCREEN_WIDTH - 1);
+			p->y = Test_Range(0, SCREEN_HEIGHT - 1);
+			break;
+	}
+}
+
+//Tests
+static void Fill_TestRect(void)
+{
+	for (int i = 0; i < FILL_RECTS; i++)
+	{
+		s32 x = Test_Range(-400, 400), y = Test_Range(-300, 300);
+		s32 w = Test_Range(-400, 400), h = Test_Range(-300, 300);
+
+		//Count the covered screen pixels, flipped rects cover the same ones
+		s32 x0 = (w < 0) ? (x + w) : x, y0 = (h < 0) ? (y + h) : y;
+		u32 count = 0;
+		for (s32 py = y0; py < y0 + abs(h); py++)
+			for (s32 px = x0; px < x0 + abs(w); px++)
+				count += (px >= 0 && px < SCREEN_WIDTH && py >= 0 && py < SCREEN_HEIGHT);
+
+		u32 area = Gfx_FillRectArea(x, y, w, h);
+		TEST_CHECK(area == count, "rect %d,%d %dx%d is %u pixels, counted %u", x, y, w, h, area, count);
+	}
+}
+
+static void Fill_TestQuad(void)
+{
+	//Quads exactly on pixel edges
+	static const POINT screen[4] = {{-50, -50}, {SCREEN_WIDTH + 50, -50}, {-50, SCREEN_HEIGHT + 50}, {SCREEN_WIDTH + 50, SCREEN_HEIGHT + 50}};
+	static const POINT inside[4] = {{10, 20}, {110, 20}, {10, 70}, {110, 70}};
+	static const POINT outside[4] = {{-200, 10}, {-100, 10}, {-200, 90}, {-100, 90}};
+	TEST_CHECK(Gfx_FillQuadArea(&screen[0], &screen[1], &screen[2], &screen[3]) == SCREEN_WIDTH * SCREEN_HEIGHT, "screen covering quad");
+	TEST_CHECK(Gfx_FillQuadArea(&inside[0], &inside[1], &inside[2], &inside[3]) == 100 * 50, "on screen quad");
+	TEST_CHECK(Gfx_FillQuadArea(&outside[0], &outside[1], &outside[2], &outside[3]) == 0, "off screen quad");
+
+	//Random quads, twisted ones included
+	for (int i = 0; i < FILL_QUADS; i++)
+	{
+		POINT p[4];
+		for (u8 j = 0; j < 4; j++)
+			Fill_RandomPoint(&p[j], i % 3);
+
+		u32 area = Gfx_FillQuadArea(&p[0], &p[1], &p[2], &p[3]);
+		long double ref = Ref_QuadArea(&p[0], &p[1], &p[2], &p[3]);
+		long double error = (area > ref) ? (area - ref) : (ref - area);
+		TEST_CHECK(error <= FILL_ERROR, "quad %d,%d %d,%d %d,%d %d,%d is %u pixels, exactly %.1Lf",
+			p[0].x, p[0].y, p[1].x, p[1].y, p[2].x, p[2].y, p[3].x, p[3].y, area, ref);
+	}
+}
+
+int main(void)
+{
+	Test_Seed(50);
+
+	Fill_TestRect();
+	Fill_TestQuad();
+
+	return Test_Result("fill");
+}
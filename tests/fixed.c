@@ -0,0 +1,135 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+//Fixed point equivalence
+//Checks FIXED_MUL32, Fixed_Mul and the hi/lo recombination the MIPS path uses against FIXED_MUL
+//Built once as a release build and once with PSXF_DEBUG for the range checks
+
+#include "test.h"
+
+#include "fixed.h"
+
+//Test constants
+#define FIXED_RUNS 200000
+
+static fixed_t Fixed_RandomOperand(void)
+{
+	//Mix tiny, screen sized and huge magnitudes of both signs
+	switch (Test_Random() & 3)
+	{
+		case 0:
+			return Test_Range(-FIXED_UNIT * 4, FIXED_UNIT * 4);
+		case 1:
+			return Test_Range(-FIXED_DEC(1024,1), FIXED_DEC(1024,1));
+		case 2:
+			return (fixed_t)Test_Random() >> (Test_Random() & 31);
+		default:
+			return (fixed_t)Test_Random();
+	}
+}
+
+static void Fixed_TestMul32(fixed_t x, fixed_t y)
+{
+	//Only defined when the whole product fits
+	s64 product = (s64)x * y;
+	if (product != (s32)product)
+		return;
+
+	fixed_t ref = FIXED_MUL(x, y);
+	fixed_t got = FIXED_MUL32(x, y);
+	TEST_CHECK(got == ref, "FIXED_MUL32(%d, %d) = %d, expected %d", (int)x, (int)y, (int)got, (int)ref);
+}
+
+static void Fixed_TestMul(fixed_t x, fixed_t y)
+{
+	//Only defined when the result fits
+	s64 result = ((s64)x * y) >> FIXED_SHIFT;
+	if (result != (fixed_t)result)
+		return;
+
+	fixed_t ref = FIXED_MUL(x, y);
+	fixed_t got = Fixed_Mul(x, y);
+	TEST_CHECK(got == ref, "Fixed_Mul(%d, %d) = %d, expected %d", (int)x, (int)y, (int)got, (int)ref);
+
+	//What mult leaves in hi/lo, put back together the way the MIPS path does
+	u64 product = (u64)((s64)x * y);
+	fixed_t hilo = FIXED_HILO((s32)(product >> 32), (u32)product);
+	TEST_CHECK(hilo == ref, "FIXED_HILO for %d * %d = %d, expected %d", (int)x, (int)y, (int)hilo, (int)ref);
+}
+
+#ifdef PSXF_DEBUG
+static void Fixed_TestChecks(void)
+{
+	//In range multiplies must not report anything
+	Test_TakeErrors();
+	Fixed_Mul(FIXED_DEC(-300,1), FIXED_DEC(3,2));
+	FIXED_MUL32(FIXED_DEC(3,2), FIXED_DEC(-5,4));
+	TEST_CHECK(Test_TakeErrors() == 0, "in range multiply reported an overflow: %s", error_msg);
+
+	//Out of range ones must report this file and line
+	char where[64];
+	int line = __LINE__ + 1;
+	FIXED_MUL32(FIXED_DEC(100,1), FIXED_DEC(100,1));
+	sprintf(where, "%s:%d", __FILE__, line);
+	TEST_CHECK(Test_TakeErrors() == 1, "FIXED_MUL32 overflow wasn't reported");
+	TEST_CHECK(strstr(error_msg, where) != NULL, "FIXED_MUL32 reported \"%s\", expected %s", error_msg, where);
+
+	line = __LINE__ + 1;
+	Fixed_Mul(FIXED_DEC(0x10000,1), FIXED_DEC(0x10000,1));
+	sprintf(where, "%s:%d", __FILE__, line);
+	TEST_CHECK(Test_TakeErrors() == 1, "Fixed_Mul overflow wasn't reported");
+	TEST_CHECK(strstr(error_msg, where) != NULL, "Fixed_Mul reported \"%s\", expected %s", error_msg, where);
+}
+#endif
+
+int main(void)
+{
+	Test_Seed(0x46495844);
+
+	//Edge operands against each other
+	static const fixed_t edge[] = {
+		0, 1, -1, FIXED_UNIT, -FIXED_UNIT, FIXED_LAND, -FIXED_LAND,
+		FIXED_DEC(1,2), FIXED_DEC(-1,2), FIXED_DEC(320,1), FIXED_DEC(-240,1),
+		0x7FFF, -0x8000, 0xB504, -0xB504, 0x7FFFFFFF, (fixed_t)0x80000000,
+	};
+	for (size_t i = 0; i < COUNT_OF(edge); i++)
+	{
+		for (size_t j = 0; j < COUNT_OF(edge); j++)
+		{
+			Fixed_TestMul32(edge[i], edge[j]);
+			Fixed_TestMul(edge[i], edge[j]);
+		}
+	}
+
+	//Random operands
+	for (u32 i = 0; i < FIXED_RUNS; i++)
+	{
+		fixed_t x = Fixed_RandomOperand();
+		fixed_t y = Fixed_RandomOperand();
+		Fixed_TestMul32(x, y);
+		Fixed_TestMul(x, y);
+	}
+
+	//The stage's own products, zoom against screen positions and speed against note times
+	for (u32 i = 0; i < FIXED_RUNS; i++)
+	{
+		fixed_t zoom = Test_Range(FIXED_DEC(1,4), FIXED_DEC(4,1));
+		fixed_t pos = Test_Range(FIXED_DEC(-2048,1), FIXED_DEC(2048,1));
+		fixed_t speed = Test_Range(FIXED_DEC(1,2), FIXED_DEC(5,1));
+		fixed_t time = Test_Range(FIXED_DEC(-2,1), FIXED_DEC(30,1)) * 150;
+		Fixed_TestMul(pos, zoom);
+		Fixed_TestMul(speed, time);
+		Fixed_TestMul32(zoom, Test_Range(FIXED_DEC(9,10), FIXED_DEC(11,10)));
+	}
+
+	#ifdef PSXF_DEBUG
+		TEST_CHECK(Test_TakeErrors() == 0, "in range multiply reported an overflow: %s", error_msg);
+		Fixed_TestChecks();
+		return Test_Result("fixed_debug");
+	#else
+		return Test_Result("fixed");
+	#endif
+}
@@ -0,0 +1,348 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+//Host rasteriser
+//Draws flat quads, every semi-transparency mode and 4bpp/8bpp CLUT textures as quads and sprites,
+//then reads the frame back from the PNG Gfx_WriteFrame saves and checks the pixels and counts
+
+#include "test.h"
+
+#include "gfx.h"
+
+//Test constants
+#define TEX_SIZE 16
+#define TEX4_X   640
+#define TEX8_X   704
+#define CLUT_Y   480
+
+#define GREY  0x80 //5-bit 16
+#define BLEND 0x40 //5-bit 8
+
+//Colour helpers, everything is compared as 15-bit
+static u16 Col_RGB(u8 r, u8 g, u8 b)
+{
+	return (r >> 3) | ((g >> 3) << 5) | ((b >> 3) << 10);
+}
+
+static u16 Col_Map(u16 col, s32 (*func)(s32 b, s32 f), u16 back)
+{
+	u16 out = 0;
+	for (u8 i = 0; i < 15; i += 5)
+	{
+		s32 c = func((back >> i) & 0x1F, (col >> i) & 0x1F);
+		if (c < 0)
+			c = 0;
+		if (c > 0x1F)
+			c = 0x1F;
+		out |= c << i;
+	}
+	return out;
+}
+
+static s32 Col_Blend0(s32 b, s32 f) { return (b + f) >> 1; }
+static s32 Col_Blend1(s32 b, s32 f) { return b + f; }
+static s32 Col_Blend2(s32 b, s32 f) { return b - f; }
+static s32 Col_Blend3(s32 b, s32 f) { return b + (f >> 2); }
+static s32 Col_Half(s32 b, s32 f) { (void)b; return (f * 0x40) >> 7; }
+
+static s32 (*const col_blend[4])(s32, s32) = {Col_Blend0, Col_Blend1, Col_Blend2, Col_Blend3};
+
+//Textures, TIMs built in memory
+static u16 clut4[16], clut8[256];
+
+static u16 Tex_Col4(u8 i)
+{
+	//Index 0 is transparent, 15 has the semi-transparency bit
+	if (i == 0)
+		return 0;
+	u16 col = i | ((15 - i) << 5) | ((i << 1) << 10);
+	return (i == 15) ? (col | 0x8000) : col;
+}
+
+static u16 Tex_Col8(u8 i)
+{
+	if (i == 0)
+		return 0;
+	return (i & 0x1F) | (((i >> 3) & 0x1F) << 5) | ((0x1F - (i & 0x1F)) << 10);
+}
+
+static u8 Tex_Index4(s32 u, s32 v) { return (u + v) & 0xF; }
+static u8 Tex_Index8(s32 u, s32 v) { return v * TEX_SIZE + u; }
+
+static u32 *Tex_Build(u8 bpp, s32 x, s32 clut_y, const u16 *clut, u8 (*index)(s32, s32))
+{
+	//id, mode, then the CLUT and pixel blocks, each a length, rect and data
+	u16 clut_len = 1 << bpp;
+	u16 words = TEX_SIZE * bpp / 16;
+	u32 clut_block = 12 + clut_len * 2;
+	u32 pixel_block = 12 + words * TEX_SIZE * 2;
+	u32 *tim = calloc(1, 8 + clut_block + pixel_block);
+
+	tim[0] = 0x10;
+	tim[1] = 0x8 | ((bpp == 4) ? 0 : 1);
+
+	u32 *block = tim + 2;
+	block[0] = clut_block;
+	u16 *p = (u16*)(block + 1);
+	*p++ = 0; *p++ = clut_y; *p++ = clut_len; *p++ = 1;
+	memcpy(p, clut, clut_len * 2);
+
+	block = (u32*)((u8*)block + clut_block);
+	block[0] = pixel_block;
+	p = (u16*)(block + 1);
+	*p++ = x; *p++ = 0; *p++ = words; *p++ = TEX_SIZE;
+	for (s32 v = 0; v < TEX_SIZE; v++)
+	{
+		for (s32 u = 0; u < TEX_SIZE; u++)
+		{
+			u16 *word = &p[v * words + u * bpp / 16];
+			*word |= index(u, v) << ((u * bpp) & 0xF);
+		}
+	}
+	return tim;
+}
+
+//Frame reading, the PNG is RGB in zlib stored blocks
+static u16 frame[SCREEN_HEIGHT][SCREEN_WIDTH];
+
+static u32 PNG_Get32(const u8 *p)
+{
+	return ((u32)p[0] << 24) | ((u32)p[1] << 16) | ((u32)p[2] << 8) | p[3];
+}
+
+static boolean Frame_Read(const char *path)
+{
+	FILE *fp = fopen(path, "rb");
+	TEST_CHECK(fp != NULL, "couldn't open %s", path);
+	if (fp == NULL)
+		return false;
+	fseek(fp, 0, SEEK_END);
+	long size = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	u8 *data = malloc(size);
+	boolean read = fread(data, 1, size, fp) == (size_t)size;
+	fclose(fp);
+	TEST_CHECK(read && size > 8 && memcmp(data, "\x89PNG\r\n\x1A\n", 8) == 0, "%s isn't a PNG", path);
+
+	//Walk the chunks
+	const u8 *idat = NULL;
+	u32 idat_len = 0, width = 0, height = 0;
+	for (long pos = 8; read && pos + 12 <= size;)
+	{
+		u32 len = PNG_Get32(data + pos);
+		const u8 *type = data + pos + 4;
+		if (memcmp(type, "IHDR", 4) == 0)
+		{
+			width = PNG_Get32(data + pos + 8);
+			height = PNG_Get32(data + pos + 12);
+			TEST_CHECK(data[pos + 16] == 8 && data[pos + 17] == 2, "PNG is depth %d colour type %d", data[pos + 16], data[pos + 17]);
+		}
+		else if (memcmp(type, "IDAT", 4) == 0)
+		{
+			idat = data + pos + 8;
+			idat_len = len;
+		}
+		pos += 12 + len;
+	}
+	TEST_CHECK(width == SCREEN_WIDTH && height == SCREEN_HEIGHT && idat != NULL, "PNG is %ux%u", width, height);
+	if (width != SCREEN_WIDTH || height != SCREEN_HEIGHT || idat == NULL)
+	{
+		free(data);
+		return false;
+	}
+
+	//Inflate the stored blocks
+	u32 stride = 1 + SCREEN_WIDTH * 3;
+	u8 *raw = malloc(stride * SCREEN_HEIGHT);
+	u32 raw_len = 0;
+	const u8 *z = idat + 2;
+	TEST_CHECK(idat[0] == 0x78, "zlib header %02X", idat[0]);
+	for (boolean last = false; !last && z + 5 <= idat + idat_len;)
+	{
+		last = z[0] & 1;
+		u32 len = z[1] | (z[2] << 8);
+		TEST_CHECK((z[0] & 6) == 0 && (len ^ (z[3] | (z[4] << 8))) == 0xFFFF, "bad stored block");
+		if (raw_len + len > stride * SCREEN_HEIGHT)
+			break;
+		memcpy(raw + raw_len, z + 5, len);
+		raw_len += len;
+		z += 5 + len;
+	}
+	TEST_CHECK(raw_len == stride * SCREEN_HEIGHT, "inflated %u bytes, expected %u", raw_len, stride * SCREEN_HEIGHT);
+
+	for (s32 y = 0; y < SCREEN_HEIGHT; y++)
+	{
+		const u8 *row = raw + y * stride;
+		TEST_CHECK(row[0] == 0, "row %d has filter %d", y, row[0]);
+		for (s32 x = 0; x < SCREEN_WIDTH; x++)
+			frame[y][x] = Col_RGB(row[1 + x * 3], row[2 + x * 3], row[3 + x * 3]);
+	}
+
+	free(raw);
+	free(data);
+	return raw_len == stride * SCREEN_HEIGHT;
+}
+
+static void Frame_CheckRect(const char *what, s32 x, s32 y, s32 w, s32 h, u16 (*expect)(s32 i, s32 j))
+{
+	for (s32 j = 0; j < h; j++)
+		for (s32 i = 0; i < w; i++)
+			TEST_CHECK(frame[y + j][x + i] == expect(i, j), "%s pixel (%d,%d) is %04X, expected %04X", what, i, j, frame[y + j][x + i], expect(i, j));
+}
+
+//Scene, each part drawn over the last since later prims are drawn first
+static const RECT flat_rect = {8, 8, 16, 16};
+#define BLEND_X(mode) (8 + (mode) * 24)
+#define BLEND_Y 40
+static const RECT tex_src = {0, 0, TEX_SIZE, TEX_SIZE};
+static const RECT draw4_dst = {8, 72, TEX_SIZE, TEX_SIZE};
+static const RECT blend4_dst = {32, 72, TEX_SIZE, TEX_SIZE};
+#define BLIT_Y 104
+static const RECT blit_src = {4, 2, 8, 8};
+
+static u16 Expect_Red(s32 i, s32 j) { (void)i; (void)j; return Col_RGB(0xFF, 0, 0); }
+static u16 Expect_Grey(s32 i, s32 j) { (void)i; (void)j; return Col_RGB(GREY, GREY, GREY); }
+static u16 Expect_Black(s32 i, s32 j) { (void)i; (void)j; return 0; }
+
+static u8 blend_mode;
+static u16 Expect_Blend(s32 i, s32 j)
+{
+	(void)i;
+	(void)j;
+	return Col_Map(Col_RGB(BLEND, BLEND, BLEND), col_blend[blend_mode], Col_RGB(GREY, GREY, GREY));
+}
+
+static u16 Expect_Draw4(s32 i, s32 j)
+{
+	u8 index = Tex_Index4(i, j);
+	return index ? (clut4[index] & 0x7FFF) : Col_RGB(GREY, GREY, GREY);
+}
+
+static u16 Expect_Blend4(s32 i, s32 j)
+{
+	//The tpage from the TIM has mode 0, only the texels with the top bit set are averaged
+	u8 index = Tex_Index4(i, j);
+	if (index == 0)
+		return Col_RGB(GREY, GREY, GREY);
+	if (clut4[index] & 0x8000)
+		return Col_Map(clut4[index], Col_Blend0, Col_RGB(GREY, GREY, GREY));
+	return clut4[index];
+}
+
+static u16 Expect_Blit8(s32 i, s32 j)
+{
+	return clut8[Tex_Index8(i, j)];
+}
+
+static u16 Expect_BlitHalf8(s32 i, s32 j)
+{
+	return Col_Map(clut8[Tex_Index8(i, j)], Col_Half, 0);
+}
+
+static u16 Expect_BlitSrc8(s32 i, s32 j)
+{
+	return clut8[Tex_Index8(blit_src.x + i, blit_src.y + j)];
+}
+
+//Tests
+static void Gfx_TestFrame(const char *path)
+{
+	for (u16 i = 0; i < 16; i++)
+		clut4[i] = Tex_Col4(i);
+	for (u16 i = 0; i < 256; i++)
+		clut8[i] = Tex_Col8(i);
+
+	Gfx_Init();
+	Gfx_SetClear(0, 0, 0);
+
+	Gfx_Tex tex4, tex8;
+	u32 *tim4 = Tex_Build(4, TEX4_X, CLUT_Y, clut4, Tex_Index4);
+	u32 *tim8 = Tex_Build(8, TEX8_X, CLUT_Y + 1, clut8, Tex_Index8);
+	Gfx_LoadTex(&tex4, tim4, GFX_LOADTEX_FREE);
+	Gfx_LoadTex(&tex8, tim8, GFX_LOADTEX_FREE);
+	TEST_CHECK(Test_TakeErrors() == 0, "loading textures raised an error: %s", error_msg);
+
+	//8bpp sprites, plain, modulated to half and from an offset in the page
+	Gfx_BlitTex(&tex8, &tex_src, 8, BLIT_Y);
+	Gfx_BlitTexCol(&tex8, &tex_src, 32, BLIT_Y, 0x40, 0x40, 0x40);
+	Gfx_BlitTex(&tex8, &blit_src, 56, BLIT_Y);
+
+	//4bpp quads over grey, drawn and blended
+	Gfx_DrawTex(&tex4, &tex_src, &draw4_dst);
+	Gfx_BlendTex(&tex4, &tex_src, &blend4_dst, 1);
+	Gfx_DrawRect(&draw4_dst, GREY, GREY, GREY);
+	Gfx_DrawRect(&blend4_dst, GREY, GREY, GREY);
+
+	//Flat quads over grey in every blend mode
+	for (u8 mode = 0; mode < 4; mode++)
+	{
+		RECT back = {BLEND_X(mode), BLEND_Y, 16, 16};
+		RECT front = {BLEND_X(mode) + 4, BLEND_Y + 4, 8, 8};
+		Gfx_BlendRect(&front, BLEND, BLEND, BLEND, mode);
+		Gfx_DrawRect(&back, GREY, GREY, GREY);
+	}
+
+	//Flat quad
+	Gfx_DrawRect(&flat_rect, 0xFF, 0, 0);
+
+	Gfx_Flip();
+	TEST_CHECK(Gfx_WriteFrame(path), "couldn't write %s", path);
+	if (!Frame_Read(path))
+		return;
+
+	//Flat, right and bottom edges aren't drawn
+	Frame_CheckRect("flat", flat_rect.x, flat_rect.y, flat_rect.w, flat_rect.h, Expect_Red);
+	Frame_CheckRect("flat right edge", flat_rect.x + flat_rect.w, flat_rect.y, 1, flat_rect.h, Expect_Black);
+	Frame_CheckRect("flat bottom edge", flat_rect.x, flat_rect.y + flat_rect.h, flat_rect.w, 1, Expect_Black);
+
+	//Blend modes, the grey border is left alone
+	for (blend_mode = 0; blend_mode < 4; blend_mode++)
+	{
+		Frame_CheckRect("blend back", BLEND_X(blend_mode), BLEND_Y, 16, 4, Expect_Grey);
+		Frame_CheckRect("blend front", BLEND_X(blend_mode) + 4, BLEND_Y + 4, 8, 8, Expect_Blend);
+	}
+
+	//Textures
+	Frame_CheckRect("4bpp quad", draw4_dst.x, draw4_dst.y, TEX_SIZE, TEX_SIZE, Expect_Draw4);
+	Frame_CheckRect("4bpp blended quad", blend4_dst.x, blend4_dst.y, TEX_SIZE, TEX_SIZE, Expect_Blend4);
+	Frame_CheckRect("8bpp sprite", 8, BLIT_Y, TEX_SIZE, TEX_SIZE, Expect_Blit8);
+	Frame_CheckRect("8bpp modulated sprite", 32, BLIT_Y, TEX_SIZE, TEX_SIZE, Expect_BlitHalf8);
+	Frame_CheckRect("8bpp offset sprite", 56, BLIT_Y, blit_src.w, blit_src.h, Expect_BlitSrc8);
+	Frame_CheckRect("8bpp offset sprite edge", 56 + blit_src.w, BLIT_Y, 1, blit_src.h, Expect_Black);
+
+	//Every covered pixel is counted, transparent texels included
+	u32 flat = 16 * 16 + 4 * 16 * 16 + 2 * TEX_SIZE * TEX_SIZE;
+	u32 semi = 8 * 8;
+	u32 tex8_pixels = 2 * TEX_SIZE * TEX_SIZE + blit_src.w * blit_src.h;
+	TEST_CHECK(Gfx_GetPixels() == flat + 4 * semi + 2 * TEX_SIZE * TEX_SIZE + tex8_pixels,
+		"touched %u pixels, expected %u", Gfx_GetPixels(), flat + 4 * semi + 2 * TEX_SIZE * TEX_SIZE + tex8_pixels);
+
+	Gfx_FillStats stats;
+	Gfx_GetFillStats(&stats);
+	TEST_CHECK(stats.pixels[GFX_FILL_FLAT][0] == flat, "%u flat pixels, expected %u", stats.pixels[GFX_FILL_FLAT][0], flat);
+	for (u8 mode = 0; mode < 4; mode++)
+		TEST_CHECK(stats.pixels[GFX_FILL_FLAT][1 + mode] == semi, "%u flat pixels in mode %d, expected %u", stats.pixels[GFX_FILL_FLAT][1 + mode], mode, semi);
+	TEST_CHECK(stats.pixels[0][0] == TEX_SIZE * TEX_SIZE && stats.pixels[0][1] == TEX_SIZE * TEX_SIZE,
+		"%u opaque and %u blended 4bpp pixels", stats.pixels[0][0], stats.pixels[0][1]);
+	TEST_CHECK(stats.pixels[1][0] == tex8_pixels, "%u 8bpp pixels, expected %u", stats.pixels[1][0], tex8_pixels);
+
+	//Nothing is drawn into the other buffer
+	Gfx_Flip();
+	TEST_CHECK(Gfx_GetPixels() == 0, "empty frame touched %u pixels", Gfx_GetPixels());
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		printf("usage: %s out.png\n", argv[0]);
+		return 1;
+	}
+
+	Gfx_TestFrame(argv[1]);
+
+	return Test_Result("gfx");
+}
@@ -0,0 +1,235 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+//Chrome trace export
+//Runs a few frames of scopes, uploads and allocations through the profiler into the file
+//PSXF_TRACE_FILE names, then reads the trace back and checks every event made it
+
+#include "test.h"
+
+#include "profiler.h"
+#include "mem.h"
+
+//Test constants
+#define TRACE_FRAMES 30
+#define TRACE_LINE   512
+
+static const char trace_upload_name[] = "\\WEEK1\\BACK.TIM;1 \"sky\"";
+
+//Trace reading
+typedef struct
+{
+	u32 frames, scopes[ProfScope_Max], uploads, allocs, frees;
+	u32 live, live_max;
+	unsigned long frame_next, frame_end;
+} Trace_Count;
+
+static boolean Trace_Field(const char *line, const char *key, char *out, size_t out_size)
+{
+	//Find "key": and copy its value, unescaping strings
+	char pattern[32];
+	sprintf(pattern, "\"%s\":", key);
+	const char *p = strstr(line, pattern);
+	if (p == NULL)
+		return false;
+	p += strlen(pattern);
+
+	size_t i = 0;
+	if (*p == '"')
+	{
+		for (p++; *p != '"'; p++)
+		{
+			if (*p == '\0')
+				return false;
+			if (*p == '\\')
+				p++;
+			if (i + 1 < out_size)
+				out[i++] = *p;
+		}
+	}
+	else
+	{
+		for (; (*p >= '0' && *p <= '9') || *p == '-'; p++)
+			if (i + 1 < out_size)
+				out[i++] = *p;
+	}
+	out[i] = '\0';
+	return i != 0;
+}
+
+static unsigned long Trace_Number(const char *line, const char *key)
+{
+	char value[32];
+	if (!Trace_Field(line, key, value, sizeof(value)))
+		return (unsigned long)-1;
+	return strtoul(value, NULL, 10);
+}
+
+static void Trace_Event(const char *line, Trace_Count *count)
+{
+	char name[64], ph[4];
+	TEST_CHECK(line[0] == '{' && line[strlen(line) - 1] == '}', "event isn't an object: %s", line);
+	TEST_CHECK(Trace_Field(line, "name", name, sizeof(name)) && Trace_Field(line, "ph", ph, sizeof(ph)), "event without a name or phase: %s", line);
+	TEST_CHECK(Trace_Number(line, "ts") != (unsigned long)-1, "event without a timestamp: %s", line);
+
+	if (strcmp(ph, "X") == 0)
+	{
+		//Complete events, frames and scopes
+		TEST_CHECK(Trace_Number(line, "dur") != (unsigned long)-1, "complete event without a duration: %s", line);
+		if (strcmp(name, "Frame") == 0)
+		{
+			unsigned long frame = Trace_Number(line, "frame");
+			TEST_CHECK(frame == count->frame_next, "frame %lu, expected %lu", frame, count->frame_next);
+
+			//Frames follow on from each other without the clock jumping
+			unsigned long ts = Trace_Number(line, "ts");
+			TEST_CHECK(frame == 0 || ts == count->frame_end, "frame %lu starts at %lu, the last one ended at %lu", frame, ts, count->frame_end);
+			count->frame_end = ts + Trace_Number(line, "dur");
+			count->frame_next++;
+			count->frames++;
+		}
+		else if (strcmp(name, "Pad_Update") == 0)
+			count->scopes[ProfScope_Pad]++;
+		else if (strcmp(name, "Characters") == 0)
+			count->scopes[ProfScope_Chars]++;
+		else if (strcmp(name, "Gfx_Flip wait") == 0)
+			count->scopes[ProfScope_Flip]++;
+		else
+			TEST_CHECK(false, "unexpected scope %s", name);
+	}
+	else if (strcmp(ph, "i") == 0)
+	{
+		//Instant events, uploads and allocations
+		char cat[16];
+		TEST_CHECK(Trace_Field(line, "cat", cat, sizeof(cat)), "instant event without a category: %s", line);
+		if (strcmp(cat, "Upload") == 0)
+		{
+			TEST_CHECK(strcmp(name, trace_upload_name) == 0, "upload named %s, expected %s", name, trace_upload_name);
+			TEST_CHECK(Trace_Number(line, "size") == 0x8000, "upload of %lu bytes", Trace_Number(line, "size"));
+			count->uploads++;
+		}
+		else if (strcmp(name, "Alloc") == 0)
+		{
+			TEST_CHECK(Trace_Number(line, "size") == 0x100, "allocation of %lu bytes", Trace_Number(line, "size"));
+			count->allocs++;
+		}
+		else if (strcmp(name, "Free") == 0)
+		{
+			count->frees++;
+		}
+		else
+		{
+			TEST_CHECK(false, "unexpected instant event %s", name);
+		}
+	}
+	else if (strcmp(ph, "C") == 0)
+	{
+		//Live allocation counter
+		unsigned long live = Trace_Number(line, "live");
+		TEST_CHECK(live == count->live + 1 || live == count->live - 1, "live allocations went from %u to %lu", count->live, live);
+		count->live = live;
+		if (count->live > count->live_max)
+			count->live_max = count->live;
+	}
+	else
+	{
+		TEST_CHECK(false, "unexpected phase %s", ph);
+	}
+}
+
+static void Trace_Read(const char *path)
+{
+	FILE *fp = fopen(path, "r");
+	TEST_CHECK(fp != NULL, "couldn't open %s", path);
+	if (fp == NULL)
+		return;
+
+	//Header, one event per line, then the footer
+	char line[TRACE_LINE];
+	TEST_CHECK(fgets(line, sizeof(line), fp) != NULL && strcmp(line, "{\"traceEvents\":[\n") == 0, "bad header: %s", line);
+
+	Trace_Count count;
+	memset(&count, 0, sizeof(count));
+	boolean footer = false;
+	while (fgets(line, sizeof(line), fp) != NULL)
+	{
+		TEST_CHECK(!footer, "event after the footer: %s", line);
+		if (strcmp(line, "],\"displayTimeUnit\":\"ms\"}\n") == 0)
+		{
+			footer = true;
+			continue;
+		}
+
+		//Every event but the last is followed by a comma
+		size_t len = strcspn(line, "\n");
+		line[len] = '\0';
+		if (len != 0 && line[len - 1] == ',')
+			line[len - 1] = '\0';
+		Trace_Event(line, &count);
+	}
+	fclose(fp);
+
+	TEST_CHECK(footer, "trace wasn't closed");
+	TEST_CHECK(count.frames == TRACE_FRAMES, "%u frames, expected %d", count.frames, TRACE_FRAMES);
+	TEST_CHECK(count.scopes[ProfScope_Pad] == TRACE_FRAMES && count.scopes[ProfScope_Chars] == TRACE_FRAMES * 3 && count.scopes[ProfScope_Flip] == TRACE_FRAMES,
+		"scopes pad %u chars %u flip %u", count.scopes[ProfScope_Pad], count.scopes[ProfScope_Chars], count.scopes[ProfScope_Flip]);
+	TEST_CHECK(count.uploads == TRACE_FRAMES / 10, "%u uploads, expected %d", count.uploads, TRACE_FRAMES / 10);
+	TEST_CHECK(count.allocs == TRACE_FRAMES * 2 && count.frees == TRACE_FRAMES * 2, "%u allocations and %u frees", count.allocs, count.frees);
+	TEST_CHECK(count.live == 0 && count.live_max == 2, "%u allocations left live, at most %u", count.live, count.live_max);
+}
+
+//Trace writing
+static void Trace_Spin(void)
+{
+	//Let the microsecond clock move
+	struct timespec ts = {0, 20000};
+	nanosleep(&ts, NULL);
+}
+
+static void Trace_Write(void)
+{
+	Profiler_Init();
+	for (int i = 0; i < TRACE_FRAMES; i++)
+	{
+		Profiler_Begin(ProfScope_Pad);
+		Trace_Spin();
+		Profiler_End(ProfScope_Pad);
+
+		void *a = Mem_Alloc(0x100);
+		void *b = Mem_Alloc(0x100);
+		for (int j = 0; j < 3; j++)
+		{
+			Profiler_Begin(ProfScope_Chars);
+			Trace_Spin();
+			Profiler_End(ProfScope_Chars);
+		}
+		Mem_Free(b);
+		Mem_Free(a);
+
+		if (i % 10 == 0)
+			Profiler_Event(ProfEvent_Upload, trace_upload_name, 0x8000);
+
+		Profiler_Begin(ProfScope_Flip);
+		Profiler_End(ProfScope_Flip);
+		Profiler_Frame();
+	}
+	Profiler_Quit();
+}
+
+int main(void)
+{
+	const char *path = getenv("PSXF_TRACE_FILE");
+	if (path == NULL)
+	{
+		printf("profiler: PSXF_TRACE_FILE isn't set\n");
+		return 1;
+	}
+
+	Trace_Write();
+	Trace_Read(path);
+
+	return Test_Result("profiler");
+}
@@ -0,0 +1,78 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "test.h"
+
+#include <stdarg.h>
+
+//Game globals the sources under test link against
+int my_argc;
+char **my_argv;
+
+char error_msg[0x200];
+
+void ErrorLock(void)
+{
+	//The game locks up here, tests count the error and carry on
+	test_errors++;
+}
+
+void FntPrint(const char *format, ...)
+{
+	(void)format;
+}
+
+void MsgPrint(const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	vprintf(format, args);
+	va_end(args);
+}
+
+//Test state
+int test_failures;
+int test_errors;
+
+static u32 test_seed;
+
+//Test functions
+void Test_Seed(u32 seed)
+{
+	test_seed = seed;
+}
+
+u32 Test_Random(void)
+{
+	//xorshift32, the same sequence on every host
+	test_seed ^= test_seed << 13;
+	test_seed ^= test_seed >> 17;
+	test_seed ^= test_seed << 5;
+	return test_seed;
+}
+
+s32 Test_Range(s32 x, s32 y)
+{
+	return x + (s32)(Test_Random() % (u32)(y - x + 1));
+}
+
+int Test_TakeErrors(void)
+{
+	int errors = test_errors;
+	test_errors = 0;
+	return errors;
+}
+
+int Test_Result(const char *name)
+{
+	if (test_failures != 0)
+	{
+		printf("%s: %d check(s) failed\n", name, test_failures);
+		return 1;
+	}
+	printf("%s: ok\n", name);
+	return 0;
+}
@@ -0,0 +1,28 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#ifndef PSXF_GUARD_TEST_H
+#define PSXF_GUARD_TEST_H
+
+#include "psx.h"
+
+#include "main.h"
+
+//Test state, defined in test.c
+extern int test_failures;
+extern int test_errors; //ErrorLock calls since the last Test_TakeErrors
+
+//Test functions
+void Test_Seed(u32 seed);
+u32 Test_Random(void);
+s32 Test_Range(s32 x, s32 y);
+int Test_TakeErrors(void);
+int Test_Result(const char *name);
+
+//Checks report the first few failures and keep going
+#define TEST_CHECK(cond, ...) do { if (!(cond)) { if (test_failures++ < 16) { printf("%s:%d: ", __FILE__, __LINE__); printf(__VA_ARGS__); printf("\n"); } } } while (0)
+
+#endif
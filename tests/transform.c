@@ -0,0 +1,185 @@
+/*
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+//Stage transform agreement
+//Models the GTE's RTPS with the matrix Stage_GTESetZoom loads and checks it against
+//MUtil_ZoomPoints, the CPU fallback, on single points and on a grid of shared vertices
+
+#include "test.h"
+
+#include "gfx.h"
+#include "mutil.h"
+#include "stage.h"
+
+//GTE setup, as Stage_GTESetZoom loads it
+#define GTE_H   256
+#define GTE_Z   (GTE_H << MUTIL_ZOOM_SUB)
+#define GTE_OFX (SCREEN_WIDTH2 << 16)
+#define GTE_OFY (SCREEN_HEIGHT2 << 16)
+
+#define GTE_FLAG_ERROR (1u << 31)
+
+//GTE model, following the documented RTPS pipeline
+static u8 gte_unr[0x101];
+
+static void GTE_Init(void)
+{
+	for (int i = 0; i < 0x101; i++)
+	{
+		int u = ((0x40000 / (i + 0x100)) + 1) / 2 - 0x101;
+		gte_unr[i] = (u < 0) ? 0 : u;
+	}
+}
+
+static s32 GTE_Lim(s64 v, s32 lo, s32 hi, u32 bit, u32 *flag)
+{
+	if (v < lo)
+	{
+		*flag |= bit;
+		return lo;
+	}
+	if (v > hi)
+	{
+		*flag |= bit;
+		return hi;
+	}
+	return (s32)v;
+}
+
+static u32 GTE_Divide(u32 h, u32 sz, u32 *flag)
+{
+	//Unsigned Newton-Raphson division
+	if (h >= sz * 2)
+	{
+		*flag |= (1 << 17);
+		return 0x1FFFF;
+	}
+	int z = 0;
+	while (z < 16 && !(sz & (0x8000 >> z)))
+		z++;
+	u64 n = (u64)h << z;
+	s64 d = (s64)sz << z;
+	s64 u = gte_unr[(d - 0x7FC0) >> 7] + 0x101;
+	d = (0x2000080 - d * u) >> 8;
+	d = (0x0000080 + d * u) >> 8;
+	u64 q = (n * d + 0x8000) >> 16;
+	return (q > 0x1FFFF) ? 0x1FFFF : (u32)q;
+}
+
+static boolean GTE_Transform(const POINT_FIXED *p, POINT *out, fixed_t zoom)
+{
+	//Vector, as Stage_GTEVector builds it
+	s32 vx = p->x >> (FIXED_SHIFT - MUTIL_ZOOM_SUB);
+	s32 vy = p->y >> (FIXED_SHIFT - MUTIL_ZOOM_SUB);
+	if (vx < -0x8000 || vx > 0x7FFF || vy < -0x8000 || vy > 0x7FFF)
+		return false;
+
+	//Rotation and translation with sf=1 and lm=0, only the diagonal and TRZ are set and vz is 0
+	u32 flag = 0;
+	s64 r = zoom << (12 - FIXED_SHIFT);
+	s64 mac1 = (r * vx) >> 12;
+	s64 mac2 = (r * vy) >> 12;
+	s64 mac3 = ((s64)GTE_Z * 0x1000) >> 12;
+	s32 ir1 = GTE_Lim(mac1, -0x8000, 0x7FFF, 1 << 24, &flag);
+	s32 ir2 = GTE_Lim(mac2, -0x8000, 0x7FFF, 1 << 23, &flag);
+	u32 sz = GTE_Lim(mac3, 0, 0xFFFF, 1 << 18, &flag);
+
+	//Perspective divide and screen offset
+	s64 n = GTE_Divide(GTE_H, sz, &flag);
+	s32 sx = GTE_Lim((n * ir1 + GTE_OFX) >> 16, -0x400, 0x3FF, 1 << 14, &flag);
+	s32 sy = GTE_Lim((n * ir2 + GTE_OFY) >> 16, -0x400, 0x3FF, 1 << 13, &flag);
+	if (flag & 0x7F87E000)
+		flag |= GTE_FLAG_ERROR;
+	if (flag & GTE_FLAG_ERROR)
+		return false;
+
+	out->x = sx;
+	out->y = sy;
+	return true;
+}
+
+//Tests
+static void Transform_TestPoints(void)
+{
+	//Any point the GTE transforms without saturating must match the CPU
+	u32 gte = 0;
+	for (u32 i = 0; i < 500000; i++)
+	{
+		POINT_FIXED p = {
+			Test_Range(FIXED_DEC(-600,1), FIXED_DEC(600,1)),
+			Test_Range(FIXED_DEC(-600,1), FIXED_DEC(600,1)),
+		};
+		fixed_t zoom = Test_Range(1, (8 << FIXED_SHIFT) - 1);
+
+		POINT g, c;
+		MUtil_ZoomPoints(&p, &c, 1, zoom);
+		if (!GTE_Transform(&p, &g, zoom))
+			continue;
+		gte++;
+		TEST_CHECK(g.x == c.x && g.y == c.y, "(%d, %d) at zoom %d: GTE %d,%d CPU %d,%d",
+			(int)p.x, (int)p.y, (int)zoom, g.x, g.y, c.x, c.y);
+	}
+	TEST_CHECK(gte > 100000, "only %u points went through the GTE model", gte);
+}
+
+static void Transform_TestGrid(void)
+{
+	//A warped grid like week 6's background, quads in alternating batches take alternating paths
+	#define GRID_W 9
+	#define GRID_H 6
+	for (u32 run = 0; run < 2000; run++)
+	{
+		POINT_FIXED grid[GRID_H][GRID_W];
+		fixed_t zoom = Test_Range(FIXED_DEC(1,2), FIXED_DEC(3,1));
+		for (int y = 0; y < GRID_H; y++)
+			for (int x = 0; x < GRID_W; x++)
+			{
+				grid[y][x].x = FIXED_DEC(x * 32 - 128, 1) + Test_Range(-FIXED_DEC(12,1), FIXED_DEC(12,1));
+				grid[y][x].y = FIXED_DEC(y * 32 - 80, 1) + Test_Range(-FIXED_DEC(12,1), FIXED_DEC(12,1));
+			}
+
+		POINT screen[GRID_H][GRID_W];
+		boolean seen[GRID_H][GRID_W];
+		memset(seen, 0, sizeof(seen));
+
+		int quad = 0;
+		for (int y = 0; y < GRID_H - 1; y++)
+		{
+			for (int x = 0; x < GRID_W - 1; x++, quad++)
+			{
+				const POINT_FIXED *p[4] = {&grid[y][x], &grid[y][x + 1], &grid[y + 1][x], &grid[y + 1][x + 1]};
+				const int px[4] = {x, x + 1, x, x + 1};
+				const int py[4] = {y, y, y + 1, y + 1};
+				boolean use_gte = (quad / STAGE_BATCH_QUADS) & 1;
+
+				for (int i = 0; i < 4; i++)
+				{
+					POINT s;
+					if (!use_gte || !GTE_Transform(p[i], &s, zoom))
+						MUtil_ZoomPoints(p[i], &s, 1, zoom);
+
+					POINT *shared = &screen[py[i]][px[i]];
+					if (seen[py[i]][px[i]])
+						TEST_CHECK(shared->x == s.x && shared->y == s.y, "vertex %d,%d of quad %d at zoom %d: %d,%d and %d,%d",
+							px[i], py[i], quad, (int)zoom, shared->x, shared->y, s.x, s.y);
+					*shared = s;
+					seen[py[i]][px[i]] = true;
+				}
+			}
+		}
+	}
+}
+
+int main(void)
+{
+	Test_Seed(0x47544521);
+	GTE_Init();
+
+	Transform_TestPoints();
+	Transform_TestGrid();
+
+	return Test_Result("transform");
+}
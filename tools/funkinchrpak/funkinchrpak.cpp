@@ -0,0 +1,299 @@
+/*
+ * funkinchrpak
+ * Packs json formatted character definitions into a binary file for the PSX port
+ *
+ * Character layout (little endian):
+ *  u8  spec
+ *  u8  health icon
+ *  u8  number of animations
+ *  u8  number of textures
+ *  u32 health bar colour
+ *  s32 focus x, y, zoom (fixed point)
+ *  u16 number of frames
+ *  u16 size of animation scripts
+ *  char textures[][12] (archive names, '\0' padded)
+ *  CharFrame frames[] (u8 tex, u8 pad, u16 src[4], s16 off[2])
+ *  Animations, each stored as:
+ *   u8  speed
+ *   u8  pad
+ *   u16 script offset from the start of the scripts
+ *  u8 scripts[]
+*/
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdint>
+
+#include "json.hpp"
+using json = nlohmann::json;
+
+#define CHAR_SPEC_MISSANIM (1 << 0) //Has miss animations
+
+#define ASCR_REPEAT 0xFF
+#define ASCR_CHGANI 0xFE
+#define ASCR_BACK   0xFD
+
+#define FIXED_SHIFT (10)
+#define FIXED_UNIT  (1 << FIXED_SHIFT)
+
+static const char *anim_names[] = {
+	"idle",
+	"left",  "leftalt",
+	"down",  "downalt",
+	"up",    "upalt",
+	"right", "rightalt",
+};
+
+void WriteWord(std::ostream &out, uint16_t word)
+{
+	out.put(word >> 0);
+	out.put(word >> 8);
+}
+
+void WriteLong(std::ostream &out, uint32_t word)
+{
+	out.put(word >> 0);
+	out.put(word >> 8);
+	out.put(word >> 16);
+	out.put(word >> 24);
+}
+
+int32_t ToFixed(const json &j)
+{
+	return (int32_t)std::floor(j.get<double>() * FIXED_UNIT + 0.5);
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 3)
+	{
+		std::cout << "usage: funkinchrpak out_chr in_json" << std::endl;
+		return 0;
+	}
+	
+	//Read json
+	std::ifstream i(argv[2]);
+	if (!i.is_open())
+	{
+		std::cout << "Failed to open " << argv[2] << std::endl;
+		return 1;
+	}
+	json j;
+	i >> j;
+	
+	//Read textures
+	std::vector<std::string> textures = j["textures"];
+	if (textures.empty() || textures.size() > 0xFF)
+	{
+		std::cout << argv[2] << " must have between 1 and 255 textures" << std::endl;
+		return 1;
+	}
+	for (auto &t : textures)
+	{
+		if (t.size() > 12)
+		{
+			std::cout << argv[2] << " texture " << t << " name is longer than 12 characters" << std::endl;
+			return 1;
+		}
+	}
+	
+	//Read frames
+	struct Frame
+	{
+		uint8_t tex;
+		uint16_t src[4];
+		int16_t off[2];
+	};
+	std::vector<Frame> frames;
+	for (auto &f : j["frames"])
+	{
+		Frame frame;
+		if (f[0].is_string())
+		{
+			size_t tex = 0;
+			while (tex < textures.size() && textures[tex] != f[0].get<std::string>())
+				tex++;
+			if (tex == textures.size())
+			{
+				std::cout << argv[2] << " frame " << frames.size() << " uses unknown texture " << f[0] << std::endl;
+				return 1;
+			}
+			frame.tex = (uint8_t)tex;
+		}
+		else
+		{
+			frame.tex = f[0];
+			if (frame.tex >= textures.size())
+			{
+				std::cout << argv[2] << " frame " << frames.size() << " uses unknown texture " << f[0] << std::endl;
+				return 1;
+			}
+		}
+		for (int k = 0; k < 4; k++)
+			frame.src[k] = f[1][k];
+		frame.off[0] = f[2][0];
+		frame.off[1] = f[2][1];
+		frames.push_back(frame);
+	}
+	if (frames.size() > ASCR_BACK)
+	{
+		std::cout << argv[2] << " has too many frames (" << frames.size() << ")" << std::endl;
+		return 1;
+	}
+	
+	//Read animations
+	struct Anim
+	{
+		uint8_t spd;
+		uint16_t script;
+	};
+	std::vector<Anim> anims;
+	std::vector<uint8_t> scripts;
+	
+	size_t num_anims = j["anims"].size();
+	if (num_anims == 0 || num_anims > 0xFF)
+	{
+		std::cout << argv[2] << " must have between 1 and 255 animations" << std::endl;
+		return 1;
+	}
+	
+	for (auto &a : j["anims"])
+	{
+		Anim anim;
+		anim.spd = a["speed"];
+		anim.script = (uint16_t)scripts.size();
+		
+		const json &script = a["script"];
+		for (size_t k = 0; k < script.size(); k++)
+		{
+			const json &op = script[k];
+			if (op.is_string())
+			{
+				std::string name = op;
+				if (name == "repeat")
+				{
+					scripts.push_back(ASCR_REPEAT);
+				}
+				else if (name == "back")
+				{
+					//Followed by the number of frames to go back
+					scripts.push_back(ASCR_BACK);
+					if (++k == script.size())
+					{
+						std::cout << argv[2] << " animation " << anims.size() << " has no back count" << std::endl;
+						return 1;
+					}
+					scripts.push_back(script[k].get<uint8_t>());
+				}
+				else if (name == "chgani")
+				{
+					//Followed by the name or index of the animation to change to
+					scripts.push_back(ASCR_CHGANI);
+					if (++k == script.size())
+					{
+						std::cout << argv[2] << " animation " << anims.size() << " has no animation to change to" << std::endl;
+						return 1;
+					}
+					size_t to;
+					if (script[k].is_string())
+					{
+						for (to = 0; to < sizeof(anim_names) / sizeof(*anim_names); to++)
+							if (script[k].get<std::string>() == anim_names[to])
+								break;
+					}
+					else
+					{
+						to = script[k];
+					}
+					if (to >= num_anims)
+					{
+						std::cout << argv[2] << " animation " << anims.size() << " changes to unknown animation " << script[k] << std::endl;
+						return 1;
+					}
+					scripts.push_back((uint8_t)to);
+				}
+				else
+				{
+					std::cout << argv[2] << " animation " << anims.size() << " has unknown command " << name << std::endl;
+					return 1;
+				}
+			}
+			else
+			{
+				size_t frame = op;
+				if (frame >= frames.size())
+				{
+					std::cout << argv[2] << " animation " << anims.size() << " uses unknown frame " << frame << std::endl;
+					return 1;
+				}
+				scripts.push_back((uint8_t)frame);
+			}
+		}
+		anims.push_back(anim);
+	}
+	if (scripts.size() > 0xFFFF)
+	{
+		std::cout << argv[2] << " animation scripts are too large" << std::endl;
+		return 1;
+	}
+	
+	//Read character information
+	uint8_t spec = 0;
+	if (j.contains("missanim") && j["missanim"].get<bool>())
+		spec |= CHAR_SPEC_MISSANIM;
+	
+	uint32_t health_b;
+	if (j["health_b"].is_string())
+		health_b = (uint32_t)std::stoul(j["health_b"].get<std::string>(), nullptr, 16);
+	else
+		health_b = j["health_b"];
+	
+	//Write character
+	std::ofstream out(argv[1], std::ostream::binary);
+	if (!out.is_open())
+	{
+		std::cout << "Failed to open " << argv[1] << std::endl;
+		return 1;
+	}
+	
+	out.put(spec);
+	out.put(j["health_i"].get<uint8_t>());
+	out.put((uint8_t)anims.size());
+	out.put((uint8_t)textures.size());
+	WriteLong(out, health_b);
+	WriteLong(out, ToFixed(j["focus"][0]));
+	WriteLong(out, ToFixed(j["focus"][1]));
+	WriteLong(out, ToFixed(j["focus"][2]));
+	WriteWord(out, (uint16_t)frames.size());
+	WriteWord(out, (uint16_t)scripts.size());
+	
+	for (auto &t : textures)
+	{
+		out.write(t.c_str(), t.size());
+		for (size_t k = t.size(); k < 12; k++)
+			out.put('\0');
+	}
+	
+	for (auto &f : frames)
+	{
+		out.put(f.tex);
+		out.put(0);
+		for (int k = 0; k < 4; k++)
+			WriteWord(out, f.src[k]);
+		WriteWord(out, f.off[0]);
+		WriteWord(out, f.off[1]);
+	}
+	
+	for (auto &a : anims)
+	{
+		out.put(a.spd);
+		out.put(0);
+		WriteWord(out, a.script);
+	}
+	
+	out.write((const char*)scripts.data(), scripts.size());
+	return 0;
+}
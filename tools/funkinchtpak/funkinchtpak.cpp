@@ -1,6 +1,17 @@
 /*
  * funkinchtpak by Regan "CuckyDev" Green
  * Packs Friday Night Funkin' json formatted charts into a binary file for the PSX port
+ *
+ * Chart layout (little endian):
+ *  s32 speed
+ *  u16 number of sections (including the terminating dummy section)
+ *  u16 number of note heads stored in the file
+ *  u16 number of notes after sustain expansion (including the dummy note)
+ *  Section sections[]
+ *  Note heads, each stored as:
+ *   varint position delta from the previous head (1/12 steps)
+ *   u8     type
+ *   varint sustain length in steps (only if type has NOTE_FLAG_SUSTAIN_END)
 */
 
 #include <iostream>
@@ -35,11 +46,19 @@ struct Note
 	uint8_t type, pad = 0;
 };
 
+struct NoteHead
+{
+	Note note;
+	uint16_t sustain; //Sustain length in steps
+};
+
 typedef int32_t fixed_t;
 
 #define FIXED_SHIFT (10)
 #define FIXED_UNIT  (1 << FIXED_SHIFT)
 
+#define CHART_SUSTAIN_MAX 16 //Must match CHART_SUSTAIN_MAX in chart.h
+
 uint16_t PosRound(double pos, double crochet)
 {
 	return (uint16_t)std::floor(pos / crochet + 0.5);
@@ -59,6 +78,16 @@ void WriteLong(std::ostream &out, uint32_t word)
 	out.put(word >> 24);
 }
 
+void WriteVarint(std::ostream &out, uint32_t value)
+{
+	while (value >= 0x80)
+	{
+		out.put((value & 0x7F) | 0x80);
+		value >>= 7;
+	}
+	out.put(value);
+}
+
 int main(int argc, char *argv[])
 {
 	if (argc < 2)
@@ -91,7 +120,8 @@ int main(int argc, char *argv[])
 	uint16_t step_base = 0;
 	
 	std::vector<Section> sections;
-	std::vector<Note> notes;
+	std::vector<NoteHead> heads;
+	size_t num_notes = 0;
 	
 	uint16_t section_end = 0;
 	int score = 0, dups = 0;
@@ -147,42 +177,50 @@ int main(int argc, char *argv[])
 			}
 			note_fudge.insert(*((uint32_t*)&new_note));
 				
-			notes.push_back(new_note);
+			NoteHead new_head;
+			new_head.note = new_note;
+			new_head.sustain = (sustain >= 0) ? (sustain + 1) : 0;
+			heads.push_back(new_head);
+			num_notes += 1 + new_head.sustain;
 			if (!(new_note.type & NOTE_FLAG_OPPONENT))
 				score += 350;
-			
-			//Push sustain notes
-			for (int k = 0; k <= sustain; k++)
-			{
-				Note sus_note; //jerma
-				sus_note.pos = new_note.pos + ((k + 1) * 12);
-				sus_note.type = new_note.type | NOTE_FLAG_SUSTAIN;
-				if (k != sustain)
-					sus_note.type &= ~NOTE_FLAG_SUSTAIN_END;
-				notes.push_back(sus_note);
-			}
 		}
 	}
 	std::cout << "max score: " << score << " dups excluded: " << dups << std::endl;
 	
-	//Sort notes
-	std::sort(notes.begin(), notes.end(), [](Note a, Note b) {
-		if (a.pos == b.pos)
-			return (b.type & NOTE_FLAG_SUSTAIN) && !(a.type & NOTE_FLAG_SUSTAIN);
-		else
-			return a.pos < b.pos;
+	//Sort note heads, sustain pieces are interleaved by the game when expanding
+	std::stable_sort(heads.begin(), heads.end(), [](const NoteHead &a, const NoteHead &b) {
+		return a.note.pos < b.note.pos;
 	});
 	
-	//Push dummy section and note
+	//Make sure the game can track every overlapping sustain
+	std::vector<uint16_t> sustain_ends;
+	for (auto &i : heads)
+	{
+		sustain_ends.erase(std::remove_if(sustain_ends.begin(), sustain_ends.end(), [&](uint16_t end) {
+			return end < i.note.pos;
+		}), sustain_ends.end());
+		if (i.sustain != 0)
+			sustain_ends.push_back(i.note.pos + i.sustain * 12);
+		if (sustain_ends.size() > CHART_SUSTAIN_MAX)
+		{
+			std::cout << argv[1] << " has more than " << CHART_SUSTAIN_MAX << " overlapping sustains at " << i.note.pos << std::endl;
+			return 1;
+		}
+	}
+	
+	//Push dummy section, the dummy note is appended by the game
 	Section dum_section;
 	dum_section.end = 0xFFFF;
 	dum_section.flag = sections[sections.size() - 1].flag;
 	sections.push_back(dum_section);
+	num_notes++;
 	
-	Note dum_note;
-	dum_note.pos = 0xFFFF;
-	dum_note.type = NOTE_FLAG_HIT;
-	notes.push_back(dum_note);
+	if (num_notes > 0xFFFF)
+	{
+		std::cout << argv[1] << " has too many notes (" << num_notes << ")" << std::endl;
+		return 1;
+	}
 	
 	//Write to output
 	std::ofstream out(std::string(argv[1]) + ".cht", std::ostream::binary);
@@ -194,7 +232,9 @@ int main(int argc, char *argv[])
 	
 	//Write header
 	WriteLong(out, (fixed_t)(speed * FIXED_UNIT));
-	WriteWord(out, 6 + (sections.size() << 2));
+	WriteWord(out, sections.size());
+	WriteWord(out, heads.size());
+	WriteWord(out, num_notes);
 	
 	//Write sections
 	for (auto &i : sections)
@@ -203,12 +243,15 @@ int main(int argc, char *argv[])
 		WriteWord(out, i.flag);
 	}
 	
-	//Write notes
-	for (auto &i : notes)
+	//Write note heads
+	uint16_t last_pos = 0;
+	for (auto &i : heads)
 	{
-		WriteWord(out, i.pos);
-		out.put(i.type);
-		out.put(0);
+		WriteVarint(out, i.note.pos - last_pos);
+		out.put(i.note.type);
+		if (i.note.type & NOTE_FLAG_SUSTAIN_END)
+			WriteVarint(out, i.sustain);
+		last_pos = i.note.pos;
 	}
 	return 0;
 }